@@ -0,0 +1,206 @@
+/*
+ * epd_bench: host microbenchmarks for the libs/epaper drawing kernels.
+ *
+ *   epd_bench [-n iterations]
+ *
+ * Times are wall clock on the host; compare the rows with each other,
+ * not with the target.
+ */
+#include <time.h>
+#include <unistd.h>
+
+#include "mgos.h"
+#include "epdpaint.h"
+#include "epdrotate.h"
+#include "gfxfont.h"
+#include "fonts/FreeSerif12pt7b.h"
+
+#define BENCH_W		200
+#define BENCH_H		200
+
+#define COLORED     0
+#define UNCOLORED   1
+
+static uint8_t _frame[BENCH_W / 8 * BENCH_H];
+static uint8_t _rotated[BENCH_W / 8 * BENCH_H];
+static volatile uint32_t _sink;
+
+
+static double bench_now_us(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static void bench_report(const char *name, const double us, const int iterations, const int pixels)
+{
+	printf("%-28s %10.1f us/frame %10.1f Mpixel/s\n", name, us / iterations,
+		(double) pixels * iterations / us);
+}
+
+/**
+ *  @brief: draw time rotation, every pixel of the frame through mgos_epdDrawPixel()
+ */
+static void bench_rotate_pixels(const enum mgos_epd_rotate_t rotate, const int iterations)
+{
+	const int stride = BENCH_W / 8;
+	char name[32];
+	double t0;
+	int i, x, y;
+
+	mgos_epd_setFrameBuffer(_rotated);
+	mgos_epd_set_width(BENCH_W);
+	mgos_epd_set_height(BENCH_H);
+	mgos_epd_set_rotate(rotate);
+
+	t0 = bench_now_us();
+	for (i = 0; i < iterations; i++) {
+		for (y = 0; y < BENCH_H; y++) {
+			for (x = 0; x < BENCH_W; x++) {
+				const int set = _frame[y * stride + (x >> 3)] & (0x80 >> (x & 0x07));
+
+				mgos_epdDrawPixel(x, y, set ? COLORED : UNCOLORED);
+			}
+		}
+		mgos_epd_clear_dirty();
+	}
+	snprintf(name, sizeof(name), "pixel rotate %d", rotate * 90);
+	bench_report(name, bench_now_us() - t0, iterations, BENCH_W * BENCH_H);
+	mgos_epd_set_rotate(ROTATE_0);
+}
+
+/**
+ *  @brief: push time rotation, the frame through the 8x8 transpose kernel
+ */
+static void bench_rotate_bands(const enum mgos_epd_rotate_t rotate, const int iterations)
+{
+	const int out_stride = BENCH_W / 8;
+	char name[32];
+	double t0;
+	int i, band;
+
+	t0 = bench_now_us();
+	for (i = 0; i < iterations; i++) {
+		for (band = 0; band * 8 < BENCH_H; band++) {
+			epd_rotate_band(_frame, BENCH_W, BENCH_H, rotate, band, &_rotated[band * 8 * out_stride]);
+		}
+		_sink += _rotated[i % sizeof(_rotated)];
+	}
+	snprintf(name, sizeof(name), "band rotate %d", rotate * 90);
+	bench_report(name, bench_now_us() - t0, iterations, BENCH_W * BENCH_H);
+}
+
+/**
+ *  @brief: the bit at a time scanline loop the GFXfont code used before
+ *          the shift-OR kernel, kept here as the reference
+ */
+static void bench_gfx_line_bitwise(const struct gfxfont_run *run, const uint8_t line, uint8_t *buf)
+{
+	const GFXfont *f = run->font;
+	uint16_t i, xx, bytepos, bitpos;
+
+	for (i=0; i<run->count; i++) {
+		const GFXglyph *glyph = run->glyphs[i].glyph;
+		int fl = glyph->yOffset - f->font_min_yOffset;
+		uint32_t bo, bo_bitoffset;
+		uint8_t bits;
+
+		if (line < fl || line >= fl + glyph->height)
+			continue;
+		bo_bitoffset = glyph->width * (line - fl);
+		bo = glyph->bitmapOffset + (bo_bitoffset / 8);
+		bo_bitoffset %= 8;
+		bits = f->bitmap[bo] << bo_bitoffset;
+		for (xx=run->glyphs[i].x; xx<run->glyphs[i].x+glyph->width; xx++) {
+			bytepos = xx >> 3;
+			bitpos = 7-(xx & 0x07);
+			if (bits & 0x80)
+				buf[bytepos] &= ~(1 << bitpos);
+			bits <<= 1;
+			if (!(++bo_bitoffset % 8))
+				bits = f->bitmap[++bo];
+		}
+	}
+}
+
+/**
+ *  @brief: rasterize a FreeSerif12pt7b line of text, bit at a time
+ *          against the shift-OR kernel in gfxfont_run_fill_line()
+ */
+static int bench_gfx_text(const int iterations)
+{
+	static const char *text = "12:34:56 The quick brown fox jumps";
+	struct gfxfont_run *run;
+	uint8_t *ref, *buf;
+	int stride, size, pixels, i, line;
+	double t0;
+
+	mgos_ili9341_set_font(&FreeSerif12pt7b);
+	run = gfxfont_run_create(text);
+	if (!run) {
+		return 1;
+	}
+	stride = (run->width + 7) / 8;
+	size = stride * run->height;
+	pixels = run->width * run->height;
+	ref = malloc(size);
+	buf = malloc(size);
+
+	t0 = bench_now_us();
+	for (i = 0; i < iterations; i++) {
+		memset(ref, 0xFF, size);
+		for (line = 0; line < run->height; line++) {
+			bench_gfx_line_bitwise(run, line, &ref[line * stride]);
+		}
+	}
+	bench_report("gfx text bitwise", bench_now_us() - t0, iterations, pixels);
+
+	t0 = bench_now_us();
+	for (i = 0; i < iterations; i++) {
+		memset(buf, 0xFF, size);
+		for (line = 0; line < run->height; line++) {
+			gfxfont_run_fill_line(run, line, &buf[line * stride], 0);
+		}
+	}
+	bench_report("gfx text shift-or", bench_now_us() - t0, iterations, pixels);
+
+	i = memcmp(ref, buf, size);
+	if (i) {
+		fprintf(stderr, "gfx text: shift-or output differs from the bitwise one\n");
+	}
+	free(ref);
+	free(buf);
+	gfxfont_run_destroy(&run);
+	return i ? 1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+	int iterations = 200;
+	int opt, i;
+
+	while ((opt = getopt(argc, argv, "n:")) != -1) {
+		switch (opt) {
+		case 'n':
+			iterations = atoi(optarg);
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-n iterations]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	srand(1);
+	for (i = 0; i < (int) sizeof(_frame); i++) {
+		_frame[i] = rand();
+	}
+
+	for (i = ROTATE_90; i <= ROTATE_270; i++) {
+		bench_rotate_pixels(i, iterations);
+		bench_rotate_bands(i, iterations * 10);
+	}
+
+	return bench_gfx_text(iterations * 10);
+}
@@ -0,0 +1,608 @@
+/*
+ * epd_emu: run a display scenario against the SSD1608 emulator and report
+ * what it cost on the wire and on the panel.
+ *
+ *   epd_emu [-o out.pbm] [-n partial_updates] [-v]
+ */
+#include <unistd.h>
+
+#include "mgos.h"
+#include "mgos_config.h"
+#include "mgos_rpc.h"
+#include "epaper.h"
+#include "epdpaint.h"
+#include "gfxfont.h"
+#include "textbox.h"
+#include "screen.h"
+#include "ssd1608_emu.h"
+
+#define COLORED     0
+#define UNCOLORED   1
+
+bool mgos_epaper_init(void);
+void widget_time_ev(int ev, struct widget_t *w, void *ev_data);
+
+/* defined by widget_time.c, which includes the font */
+extern GFXfont FreeSerif12pt7b;
+
+static uint8_t imagebuffer[1024];
+static uint8_t framebuffer[200 / 8 * 200];
+static uint8_t rotatedbuffer[200 / 8 * 200];
+static struct ssd1608_emu_stats _phase_start;
+static int64_t _phase_start_us;
+
+
+static void emu_phase_begin(void)
+{
+	_phase_start = *ssd1608_emu_get_stats();
+	_phase_start_us = mgos_uptime_micros();
+}
+
+static void emu_phase_end(const char *name, const int count)
+{
+	const struct ssd1608_emu_stats *st = ssd1608_emu_get_stats();
+	int n = (count > 0) ? count : 1;
+
+	printf("%-16s %5d %8.1f %9.1f %8.1f %8.1f %10.1f %10.1f\n", name, count,
+		(double)(st->spi_txns - _phase_start.spi_txns) / n,
+		(double)(st->spi_bytes - _phase_start.spi_bytes) / n,
+		(double)(st->dc_toggles - _phase_start.dc_toggles) / n,
+		(double)(st->refreshes - _phase_start.refreshes) / n,
+		(double)(st->busy_us - _phase_start.busy_us) / 1000.0 / n,
+		(double)(mgos_uptime_micros() - _phase_start_us) / 1000.0 / n);
+}
+
+static void emu_draw_time(const int sec)
+{
+	char buf[16];
+
+	snprintf(buf, sizeof(buf), "12:34:%02d", sec % 60);
+	mgos_epd_set_rotate(ROTATE_0);
+	mgos_epd_set_width(128);
+	mgos_epd_set_height(24);
+	mgos_epd_clear(UNCOLORED);
+	mgos_epd_draw_string_at(0, 0, buf, &Font24, COLORED);
+	mgos_epd_pushDirty(40, 85);
+}
+
+/**
+ *  @brief: Draw a whole panel frame with the clock at sec
+ */
+static void emu_draw_frame(const int sec)
+{
+	char buf[16];
+
+	snprintf(buf, sizeof(buf), "12:34:%02d", sec % 60);
+	mgos_epd_setFrameBuffer(framebuffer);
+	mgos_epd_set_rotate(ROTATE_0);
+	mgos_epd_set_width(mgos_host_config.size_x);
+	mgos_epd_set_height(mgos_host_config.size_y);
+	mgos_epd_clear(UNCOLORED);
+	mgos_epd_draw_string_at(2, 2, "Frame diff", &Font20, COLORED);
+	mgos_epd_draw_string_at(40, 85, buf, &Font24, COLORED);
+	mgos_epd_draw_string_at(4, 180, "bottom line", &Font12, COLORED);
+	mgos_epd_setFrameBuffer(imagebuffer);
+}
+
+/**
+ *  @brief: Draw a whole panel frame in the given orientation
+ */
+static void emu_draw_oriented(uint8_t *buf, const enum mgos_epd_rotate_t rotate)
+{
+	mgos_epd_setFrameBuffer(buf);
+	mgos_epd_set_rotate(rotate);
+	mgos_epd_set_width(mgos_host_config.size_x);
+	mgos_epd_set_height(mgos_host_config.size_y);
+	mgos_epd_clear(UNCOLORED);
+	mgos_epd_draw_string_at(2, 2, "Portrait", &Font20, COLORED);
+	mgos_epd_draw_filled_rectangle(10, 40, 90, 60, COLORED);
+	mgos_epd_drawCircle(140, 120, 30, COLORED);
+	mgos_epd_draw_string_at(4, 180, "rotated at push", &Font12, COLORED);
+	mgos_epd_set_rotate(ROTATE_0);
+	mgos_epd_setFrameBuffer(imagebuffer);
+}
+
+/*
+ * Widgets for the screen scenarios: a solid block, black while colored,
+ * pushed whole or with mgos_epd_pushDirty() from a buffer of its own.
+ */
+struct emu_block {
+	bool colored;
+	bool dirty;				// push with mgos_epd_pushDirty()
+	int draws;
+	int timers;
+	int64_t fired_ms[16];	// uptime of the first EV_WIDGET_TIMERs
+	uint8_t buf[64 / 8 * 64];
+};
+
+static void emu_block_ev(int ev, struct widget_t *w, void *ev_data)
+{
+	struct emu_block *b = (struct emu_block *) w->user_data;
+	uint8_t *saved_fb;
+	int saved_w, saved_h;
+
+	switch (ev) {
+	case EV_WIDGET_DRAW:
+	case EV_WIDGET_REDRAW:
+		b->draws++;
+		if (!b->dirty) {
+			memset(b->buf, b->colored ? 0x00 : 0xFF, sizeof(b->buf));
+			mgos_epd_pushFrameBuffer(b->buf, w->x, w->y, w->w, w->h);
+			break;
+		}
+		saved_fb = mgos_epd_getFrameBuffer();
+		saved_w = mgos_epd_get_width();
+		saved_h = mgos_epd_get_height();
+		mgos_epd_setFrameBuffer(b->buf);
+		mgos_epd_set_width(w->w);
+		mgos_epd_set_height(w->h);
+		mgos_epd_clear(b->colored ? COLORED : UNCOLORED);
+		mgos_epd_pushDirty(w->x, w->y);
+		mgos_epd_setFrameBuffer(saved_fb);
+		mgos_epd_set_width(saved_w);
+		mgos_epd_set_height(saved_h);
+		break;
+	case EV_WIDGET_TIMER:
+		if (b->timers < (int) (sizeof(b->fired_ms) / sizeof(b->fired_ms[0]))) {
+			b->fired_ms[b->timers] = mgos_uptime_micros() / 1000;
+		}
+		b->timers++;
+		b->colored = !b->colored;
+		widget_invalidate(w);
+		break;
+	}
+	(void) ev_data;
+}
+
+static struct widget_t *emu_block_add(struct screen_t *s, char *name, const int x, const int y, const int w, const int h,
+	const int z, const bool opaque, const bool dirty)
+{
+	struct widget_t *widget = widget_create(name, x, y, w, h);
+	struct emu_block *b = (struct emu_block *) calloc(1, sizeof(*b));
+
+	b->dirty = dirty;
+	widget->z = z;
+	widget->opaque = opaque;
+	widget_set_handler(widget, emu_block_ev, b);
+	screen_widget_add(s, widget);
+	return widget;
+}
+
+static struct emu_block *emu_block(struct widget_t *w)
+{
+	return (struct emu_block *) w->user_data;
+}
+
+/**
+ *  @brief: true if every pixel of the rectangle on glass is black, or white
+ */
+static bool emu_display_is(const int x, const int y, const int w, const int h, const bool black)
+{
+	const uint8_t *d = ssd1608_emu_get_display();
+	int i, j;
+
+	for (j=y; j<y+h; j++) {
+		for (i=x; i<x+w; i++) {
+			if (((d[j * (mgos_host_config.size_x / 8) + i / 8] >> (7 - (i & 0x07))) & 1) == black) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+static void emu_clear_panel(void)
+{
+	int i;
+
+	for (i=0; i<2; i++) {
+		mgos_epd_clear_frame_memory(0xFF);
+		mgos_epd_display_frame();
+	}
+}
+
+static uint32_t emu_refreshes(void)
+{
+	return ssd1608_emu_get_stats()->refreshes;
+}
+
+/**
+ *  @brief: one refresh per frame, and a widget drawn in one frame has to
+ *          survive the next frame, which refreshes the other RAM bank
+ */
+static bool emu_screen_frames(void)
+{
+	struct screen_t *s = screen_create("frames");
+	struct widget_t *a = emu_block_add(s, "a", 0, 0, 64, 32, 0, false, false);
+	struct widget_t *b = emu_block_add(s, "b", 0, 64, 64, 32, 0, false, false);
+	uint32_t refreshes;
+	uint16_t x, y, w, h;
+	int i;
+
+	screen_render(s);
+	emu_block(a)->colored = true;
+	widget_invalidate(a);
+	for (i=0; i<3; i++) {
+		if (i > 0) {
+			/* from now on only b changes */
+			widget_invalidate(b);
+		}
+		refreshes = emu_refreshes();
+		if (screen_render(s) == 0 || (emu_refreshes() != refreshes + 1)) {
+			fprintf(stderr, "screen frames: frame %d took %u refreshes\n", i, emu_refreshes() - refreshes);
+			return false;
+		}
+		if (!emu_display_is(0, 0, 64, 32, true) || !emu_display_is(0, 64, 64, 32, false)) {
+			fprintf(stderr, "screen frames: widget a came undone in frame %d\n", i);
+			return false;
+		}
+	}
+	/* a has been drawn into both banks, the last frame was b alone */
+	if (!screen_get_damage(s, &x, &y, &w, &h) || (y != 64) || (h != 32)) {
+		fprintf(stderr, "screen frames: damage %u,%u %ux%u\n", x, y, w, h);
+		return false;
+	}
+
+	refreshes = emu_refreshes();
+	screen_render(s);
+	screen_render(s);
+	if (emu_refreshes() != refreshes) {
+		fprintf(stderr, "screen frames: frames without changes refreshed the panel\n");
+		return false;
+	}
+
+	screen_destroy(&s);
+	widget_destroy(&a);
+	widget_destroy(&b);
+	return true;
+}
+
+/**
+ *  @brief: a widget invalidated outside a timer is drawn by the screen tick
+ */
+static bool emu_screen_invalidate(void)
+{
+	struct screen_t *s = screen_create("invalidate");
+	struct widget_t *a = emu_block_add(s, "a", 64, 0, 64, 32, 0, false, false);
+	bool ok;
+
+	mgos_host_run_for(1000);
+	emu_block(a)->colored = true;
+	widget_invalidate(a);
+	mgos_host_run_for(3000);
+	ok = (emu_block(a)->draws == 2) && emu_display_is(64, 0, 64, 32, true);
+	if (!ok) {
+		fprintf(stderr, "screen invalidate: drawn %d times\n", emu_block(a)->draws);
+	}
+
+	screen_destroy(&s);
+	widget_destroy(&a);
+	return ok;
+}
+
+/**
+ *  @brief: widget timers of 500, 1000 and 2000 ms fire in the same ticks,
+ *          with one refresh per tick
+ */
+static bool emu_screen_tick(void)
+{
+	struct screen_t *s = screen_create("tick");
+	struct widget_t *w[3];
+	const int period[3] = { 500, 1000, 2000 };
+	uint32_t refreshes;
+	int i, j, k, events = 0;
+	bool ok = true;
+
+	for (i=0; i<3; i++) {
+		w[i] = emu_block_add(s, "t", 64 * i, 100, 64, 32, 0, false, false);
+		widget_set_timer(w[i], period[i]);
+	}
+	mgos_host_run_for(100);
+	refreshes = emu_refreshes();
+	mgos_host_run_for(4000);
+
+	for (i=0; i<3; i++) {
+		struct emu_block *b = emu_block(w[i]);
+
+		events += b->timers;
+		ok &= (b->timers >= 4000 / period[i] - 1);
+		/* every deadline of a slower widget is one of the 500 ms widget's */
+		for (j=0; (i>0) && (j<b->timers) && (j<16); j++) {
+			for (k=0; (k<emu_block(w[0])->timers) && (emu_block(w[0])->fired_ms[k] != b->fired_ms[j]); k++);
+			ok &= (k < emu_block(w[0])->timers);
+		}
+	}
+	if (!ok || (emu_refreshes() - refreshes > (uint32_t) emu_block(w[0])->timers)) {
+		fprintf(stderr, "screen tick: %d timer events, %u refreshes\n", events, emu_refreshes() - refreshes);
+		ok = false;
+	}
+
+	screen_destroy(&s);
+	for (i=0; i<3; i++) {
+		widget_destroy(&w[i]);
+	}
+	return ok;
+}
+
+/**
+ *  @brief: z order for drawing and hit tests, hidden widgets aren't drawn,
+ *          and what an opaque widget hid shows again once it is gone
+ */
+static bool emu_screen_occlusion(void)
+{
+	struct screen_t *s = screen_create("occlusion");
+	struct widget_t *d = emu_block_add(s, "d", 0, 0, 64, 32, 0, false, true);
+	struct widget_t *o = emu_block_add(s, "o", 0, 0, 64, 16, 1, true, false);
+	struct widget_t *p = emu_block_add(s, "p", 96, 96, 48, 48, 2, true, false);
+	struct widget_t *h = emu_block_add(s, "h", 104, 104, 32, 32, 0, false, false);
+	struct widget_t *f = emu_block_add(s, "f", 160, 0, 32, 32, 0, false, false);
+	bool ok = true;
+	int i;
+
+	emu_block(d)->colored = true;
+	screen_render(s);
+	if (emu_block(h)->draws || !emu_display_is(0, 0, 64, 16, false) || !emu_display_is(0, 16, 64, 16, true)) {
+		fprintf(stderr, "screen occlusion: hidden widget drawn or opaque widget not on top\n");
+		ok = false;
+	}
+	if ((screen_widget_find_by_xy(s, 110, 110) != p) || (screen_widget_find_by_xy(s, 5, 5) != o) ||
+		(screen_widget_find_by_xy(s, 5, 20) != d) || screen_widget_find_by_xy(s, 80, 5)) {
+		fprintf(stderr, "screen occlusion: hit test does not follow the z order\n");
+		ok = false;
+	}
+
+	screen_widget_destroy(s, &o);
+	for (i=0; ok && (i<3); i++) {
+		screen_render(s);
+		if (!emu_display_is(0, 0, 64, 32, true)) {
+			fprintf(stderr, "screen occlusion: frame %d still shows the destroyed widget\n", i);
+			ok = false;
+		}
+		widget_invalidate(f);
+	}
+	if (screen_widget_find_by_xy(s, 5, 5) != d) {
+		fprintf(stderr, "screen occlusion: hit test finds a destroyed widget\n");
+		ok = false;
+	}
+
+	screen_destroy(&s);
+	widget_destroy(&d);
+	widget_destroy(&p);
+	widget_destroy(&h);
+	widget_destroy(&f);
+	return ok;
+}
+
+/**
+ *  @brief: the demo clock keeps its Font24 line inside the widget clip
+ */
+static bool emu_screen_clock(void)
+{
+	struct screen_t *s = screen_create("clock");
+	struct widget_t *w = widget_create("time", 32, 60, 144, 112);
+	bool ok;
+
+	widget_set_handler(w, widget_time_ev, NULL);
+	screen_widget_add(s, w);
+	screen_render(s);
+	/* the last digit of "hh:mm:ss" is at 159..175, a 128 px line ends at 168 */
+	ok = !emu_display_is(168, 85, 8, 24, false);
+	if (!ok) {
+		fprintf(stderr, "screen clock: the last digit was clipped\n");
+	}
+
+	screen_destroy(&s);
+	widget_destroy(&w);
+	return ok;
+}
+
+static void emu_async_done(void *arg)
+{
+	*(bool *)arg = true;
+}
+
+int main(int argc, char **argv)
+{
+	const char *out = "epd_emu.pbm";
+	int updates = 10;
+	int opt, i;
+	bool done = false;
+
+	while ((opt = getopt(argc, argv, "o:n:v")) != -1) {
+		switch (opt) {
+		case 'o':
+			out = optarg;
+			break;
+		case 'n':
+			updates = atoi(optarg);
+			break;
+		case 'v':
+			mgos_host_log_level = LL_DEBUG;
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-o out.pbm] [-n partial_updates] [-v]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	ssd1608_emu_init(mgos_host_config.size_x, mgos_host_config.size_y);
+	mgos_epd_setFrameBuffer(imagebuffer);
+
+	printf("%-16s %5s %8s %9s %8s %8s %10s %10s\n", "phase", "count", "txns", "bytes", "dc", "refresh", "busy_ms", "elapsed_ms");
+
+	emu_phase_begin();
+	mgos_epaper_init();
+	emu_phase_end("init", 1);
+
+	emu_phase_begin();
+	for (i=0; i<2; i++) {
+		mgos_epd_clear_frame_memory(0xFF);
+		mgos_epd_display_frame();
+	}
+	emu_phase_end("clear", 2);
+
+	emu_phase_begin();
+	for (i=0; i<2; i++) {
+		mgos_epd_set_rotate(ROTATE_0);
+		mgos_epd_set_width(200);
+		mgos_epd_set_height(24);
+		mgos_epd_clear(COLORED);
+		mgos_epd_draw_string_at(2, 2, "Hello Mongoose!", &Font20_RLE, UNCOLORED);
+		mgos_epd_pushFrameBuffer(mgos_epd_getFrameBuffer(), 0, 10, mgos_epd_get_width(), mgos_epd_get_height());
+		mgos_epd_clear(UNCOLORED);
+		mgos_epd_draw_string_at(5, 4, "* Using native mgos_spi.h", &Font12_RLE, COLORED);
+		mgos_epd_pushFrameBuffer(mgos_epd_getFrameBuffer(), 0, 50, mgos_epd_get_width(), mgos_epd_get_height());
+		emu_draw_time(0);
+		mgos_epd_display_frame();
+	}
+	emu_phase_end("full update", 2);
+
+	emu_phase_begin();
+	mgos_epd_display_init(PARTIAL_UPDATE);
+	emu_phase_end("partial init", 1);
+
+	emu_phase_begin();
+	for (i=1; i<=updates; i++) {
+		emu_draw_time(i);
+		mgos_epd_display_frame();
+	}
+	emu_phase_end("partial update", updates);
+
+	emu_phase_begin();
+	for (i=0; i<=updates; i++) {
+		emu_draw_frame(i);
+		mgos_epd_push_diff(framebuffer);
+		mgos_epd_display_frame();
+		if (memcmp(ssd1608_emu_get_display(), framebuffer, sizeof(framebuffer))) {
+			fprintf(stderr, "frame diff: display does not match frame %d\n", i);
+			return 1;
+		}
+		if (i == 1) {
+			emu_phase_end("diff first", 2);
+			emu_phase_begin();
+		}
+	}
+	emu_phase_end("diff update", updates - 1);
+
+	emu_phase_begin();
+	mgos_ili9341_set_font(&FreeSerif12pt7b);
+	for (i=0; i<updates; i++) {
+		char buf[16];
+
+		snprintf(buf, sizeof(buf), "12:34:%02d", i % 60);
+		mgos_epd_print(40, 120, buf);
+		mgos_epd_display_frame();
+	}
+	emu_phase_end("gfx print", updates);
+
+	/* a paragraph laid out once and redrawn unchanged */
+	emu_phase_begin();
+	{
+		struct textbox_t *tb = textbox_create(176, 80);
+
+		textbox_set_align(tb, TEXTBOX_ALIGN_CENTER);
+		textbox_set_text(tb, "Sensor 3 reports a battery level below ten percent, "
+			"replace it soon to keep the readings coming in.");
+		for (i=0; i<updates; i++) {
+			textbox_draw(tb, 8, 120);
+			mgos_epd_display_frame();
+		}
+		if (textbox_get_num_lines(tb) != 3) {
+			fprintf(stderr, "text box: %u lines\n", textbox_get_num_lines(tb));
+			return 1;
+		}
+		textbox_destroy(&tb);
+	}
+	emu_phase_end("text box", updates);
+
+	emu_phase_begin();
+	emu_draw_time(updates + 1);
+	mgos_epd_display_frame_async(emu_async_done, &done);
+	for (i=0; (i<500) && !done; i++) {
+		mgos_host_run_for(10);
+	}
+	emu_phase_end("async refresh", 1);
+	if (!done) {
+		fprintf(stderr, "asynchronous refresh did not complete\n");
+		return 1;
+	}
+
+	emu_phase_begin();
+	for (i=ROTATE_90; i<=ROTATE_270; i++) {
+		emu_draw_oriented(framebuffer, ROTATE_0);
+		emu_draw_oriented(rotatedbuffer, i);
+		mgos_epd_pushFrameBufferRotated(framebuffer, mgos_host_config.size_x, mgos_host_config.size_y, i, 0, 0);
+		mgos_epd_display_frame();
+		if (memcmp(ssd1608_emu_get_display(), rotatedbuffer, sizeof(rotatedbuffer))) {
+			fprintf(stderr, "rotated push: display does not match rotation %d\n", i);
+			return 1;
+		}
+	}
+	emu_phase_end("rotated push", 3);
+
+	emu_clear_panel();
+	emu_phase_begin();
+	if (!emu_screen_frames()) {
+		return 1;
+	}
+	emu_phase_end("screen frames", 5);
+
+	emu_phase_begin();
+	if (!emu_screen_invalidate()) {
+		return 1;
+	}
+	emu_phase_end("screen invalid.", 2);
+
+	emu_phase_begin();
+	if (!emu_screen_tick()) {
+		return 1;
+	}
+	emu_phase_end("screen tick", 1);
+
+	emu_clear_panel();
+	emu_phase_begin();
+	if (!emu_screen_occlusion()) {
+		return 1;
+	}
+	emu_phase_end("screen occlusion", 4);
+
+	emu_clear_panel();
+	emu_phase_begin();
+	if (!emu_screen_clock()) {
+		return 1;
+	}
+	emu_phase_end("screen clock", 1);
+
+	{
+		const struct mgos_epd_stats *st = mgos_epd_get_stats();
+
+		printf("driver: %u txns, %u bytes, %u dc toggles, %u ms blocked on BUSY, "
+			"%u full + %u partial refreshes, last %u ms, max %u ms\n",
+			st->spi_txns, st->spi_bytes, st->dc_toggles, st->busy_wait_ms,
+			st->full_refreshes, st->partial_refreshes, st->last_refresh_ms, st->max_refresh_ms);
+	}
+
+	{
+		char resp[512];
+
+		if (!mgos_host_rpc_call("EPD.Stats", "{\"reset\": true}", resp, sizeof(resp)) || !strstr(resp, "\"spi_txns\":")) {
+			fprintf(stderr, "EPD.Stats: no response\n");
+			return 1;
+		}
+		printf("EPD.Stats: %s\n", resp);
+		if (mgos_epd_get_stats()->spi_txns != 0) {
+			fprintf(stderr, "EPD.Stats: reset did not clear the counters\n");
+			return 1;
+		}
+	}
+
+	if (ssd1608_emu_get_stats()->busy_violations) {
+		printf("WARNING: %u bytes were sent while BUSY was high\n", ssd1608_emu_get_stats()->busy_violations);
+	}
+	if (!ssd1608_emu_write_pbm(out)) {
+		return 1;
+	}
+	printf("display image written to %s\n", out);
+
+	return 0;
+}
@@ -0,0 +1,215 @@
+/*
+ * fontpack: run length compress the built in sFONT tables.
+ *
+ *   fontpack > ../src/fonts_rle.c
+ *
+ * Writes FontNN_RLE in the format read by font_rle.c for every font that
+ * gets smaller, checks every glyph decodes back to the table it came from
+ * and prints the sizes on stderr. Font8 doesn't: its glyphs are 8 bytes,
+ * the offsets alone take a quarter of that.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fonts.h"
+
+#define GLYPHS		('~' - ' ' + 1)
+
+struct packed {
+	uint8_t *data;
+	int len, size;
+	int nibble;
+	uint16_t offsets[GLYPHS + 1];
+};
+
+static const struct {
+	const char *name;
+	const sFONT *font;
+} _fonts[] = {
+	{ "Font8", &Font8 },
+	{ "Font12", &Font12 },
+	{ "Font16", &Font16 },
+	{ "Font20", &Font20 },
+	{ "Font24", &Font24 },
+};
+
+
+static void packed_byte(struct packed *pk, const uint8_t b)
+{
+	if (pk->len == pk->size) {
+		pk->size = pk->size ? pk->size * 2 : 1024;
+		pk->data = realloc(pk->data, pk->size);
+		if (!pk->data) {
+			perror("realloc");
+			exit(1);
+		}
+	}
+	pk->data[pk->len++] = b;
+}
+
+static void packed_nibble(struct packed *pk, const int n)
+{
+	if (pk->nibble) {
+		pk->data[pk->len - 1] |= n;
+	} else {
+		packed_byte(pk, n << 4);
+	}
+	pk->nibble ^= 1;
+}
+
+static void packed_run(struct packed *pk, int len)
+{
+	for (; len >= 15; len -= 15) {
+		packed_nibble(pk, 15);
+	}
+	packed_nibble(pk, len);
+}
+
+static int glyph_bit(const sFONT *font, const uint8_t *glyph, const int i)
+{
+	const int stride = (font->Width + 7) >> 3;
+	const int x = i % font->Width, y = i / font->Width;
+
+	return (glyph[y * stride + (x >> 3)] >> (7 - (x & 0x07))) & 1;
+}
+
+/**
+ *  @brief: append one glyph, compressed unless that doesn't make it smaller
+ */
+static void pack_glyph(struct packed *pk, const sFONT *font, const int index)
+{
+	const int stride = (font->Width + 7) >> 3;
+	const int raw = stride * font->Height;
+	const int bits = font->Width * font->Height;
+	const uint8_t *glyph = &font->table[index * raw];
+	const int start = pk->len;
+	int i = 0, color = 0, run;
+
+	pk->nibble = 0;
+	while (i < bits) {
+		for (run = 0; (i < bits) && (glyph_bit(font, glyph, i) == color); i++) {
+			run++;
+		}
+		/* the trailing clear run is implied */
+		if ((i == bits) && !color) {
+			break;
+		}
+		packed_run(pk, run);
+		color ^= 1;
+	}
+
+	pk->offsets[index] = start;
+	if (pk->len - start >= raw) {
+		pk->len = start;
+		for (i = 0; i < raw; i++) {
+			packed_byte(pk, glyph[i]);
+		}
+		pk->offsets[index] |= SFONT_RLE_RAW;
+	}
+}
+
+/**
+ *  @brief: decode every glyph again and compare it with the table
+ */
+static int pack_check(const char *name, const sFONT *font, const sFONT *packed)
+{
+	const int stride = (font->Width + 7) >> 3;
+	struct sfont_row_decoder d;
+	uint8_t row[SFONT_ROW_MAX];
+	int c, y;
+
+	for (c = ' '; c <= '~'; c++) {
+		if (!sfont_glyph_begin(&d, packed, c)) {
+			fprintf(stderr, "%s: no glyph for '%c'\n", name, c);
+			return 1;
+		}
+		for (y = 0; y < font->Height; y++) {
+			sfont_glyph_row(&d, row);
+			if (memcmp(row, &font->table[((c - ' ') * font->Height + y) * stride], stride)) {
+				fprintf(stderr, "%s: glyph '%c' row %d does not decode back\n", name, c, y);
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
+
+static void pack_print(const char *name, const sFONT *font, const struct packed *pk)
+{
+	int i;
+
+	printf("static const uint8_t %s_RLE_Data[%d] = {", name, pk->len);
+	for (i = 0; i < pk->len; i++) {
+		printf("%s0x%02X,", (i % 16) ? " " : "\n\t", pk->data[i]);
+	}
+	printf("\n};\n\n");
+
+	printf("static const uint16_t %s_RLE_Offsets[%d] = {", name, GLYPHS + 1);
+	for (i = 0; i <= GLYPHS; i++) {
+		printf("%s0x%04X,", (i % 8) ? " " : "\n\t", pk->offsets[i]);
+	}
+	printf("\n};\n\n");
+
+	printf("sFONT %s_RLE = {\n", name);
+	printf("\tNULL,\n");
+	printf("\t%d, /* Width */\n", font->Width);
+	printf("\t%d, /* Height */\n", font->Height);
+	printf("\t%s_RLE_Data,\n", name);
+	printf("\t%s_RLE_Offsets,\n", name);
+	printf("};\n\n");
+}
+
+int main(void)
+{
+	int f, i, raw_total = 0, packed_total = 0;
+
+	printf("/*\n"
+		" * Run length compressed copies of the sFONT tables, see font_rle.c.\n"
+		" * Generated by libs/epaper/host/fontpack, do not edit.\n"
+		" */\n"
+		"#include <stddef.h>\n\n"
+		"#include \"fonts.h\"\n\n");
+
+	for (f = 0; f < (int) (sizeof(_fonts) / sizeof(_fonts[0])); f++) {
+		const sFONT *font = _fonts[f].font;
+		const int raw = GLYPHS * font->Height * ((font->Width + 7) >> 3);
+		struct packed pk;
+		sFONT packed = { 0 };
+		int raw_glyphs = 0, size;
+
+		memset(&pk, 0, sizeof(pk));
+		for (i = 0; i < GLYPHS; i++) {
+			pack_glyph(&pk, font, i);
+			raw_glyphs += (pk.offsets[i] & SFONT_RLE_RAW) ? 1 : 0;
+		}
+		pk.offsets[GLYPHS] = pk.len;
+		if (pk.len >= SFONT_RLE_RAW) {
+			fprintf(stderr, "%s: %d bytes don't fit the offsets\n", _fonts[f].name, pk.len);
+			return 1;
+		}
+
+		packed.Width = font->Width;
+		packed.Height = font->Height;
+		packed.rle = pk.data;
+		packed.rle_offsets = pk.offsets;
+		if (pack_check(_fonts[f].name, font, &packed)) {
+			return 1;
+		}
+
+		size = pk.len + sizeof(pk.offsets);
+		fprintf(stderr, "%-8s %5d -> %5d bytes (%d%%), %d glyphs raw%s\n", _fonts[f].name, raw, size,
+			100 * size / raw, raw_glyphs, (size < raw) ? "" : ", left out");
+		if (size < raw) {
+			pack_print(_fonts[f].name, font, &pk);
+			raw_total += raw;
+			packed_total += size;
+		}
+		free(pk.data);
+	}
+
+	fprintf(stderr, "total    %5d -> %5d bytes (%d%%)\n", raw_total, packed_total, 100 * packed_total / raw_total);
+	return 0;
+}
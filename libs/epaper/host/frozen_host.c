@@ -0,0 +1,224 @@
+/*
+ * Host stand-in for the frozen JSON calls used by libs/epaper: enough to
+ * read widget and screen JSON and RPC arguments, not a full parser.
+ * json_scanf() takes a flat format of top level keys, "{a:%d,b:%B,c:%Q}",
+ * and fills in the ones the JSON has; %Q strings are malloc()ed.
+ */
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "frozen/frozen.h"
+
+#define JSON_KEY_MAX	32
+
+
+static const char *json_skip_ws(const char *p, const char *end)
+{
+	while (p < end && isspace((unsigned char) *p)) {
+		p++;
+	}
+	return p;
+}
+
+/**
+ *  @brief: the end of the value at p: a string, number, literal, object or array
+ */
+static const char *json_skip_value(const char *p, const char *end)
+{
+	int depth = 0;
+
+	p = json_skip_ws(p, end);
+	do {
+		if (p >= end) {
+			return end;
+		}
+		if (*p == '"') {
+			for (p++; p < end && *p != '"'; p++) {
+				if (*p == '\\') {
+					p++;
+				}
+			}
+			p++;
+		} else if (*p == '{' || *p == '[') {
+			depth++;
+			p++;
+		} else if (*p == '}' || *p == ']') {
+			depth--;
+			p++;
+		} else if (depth == 0) {
+			while (p < end && !strchr(",}] \t\r\n", *p)) {
+				p++;
+			}
+		} else {
+			p++;
+		}
+	} while (depth > 0);
+	return p;
+}
+
+/**
+ *  @brief: the value of key in the object at obj, NULL if it has none
+ */
+static const char *json_find_key(const char *obj, const char *end, const char *key, const size_t key_len)
+{
+	const char *p = json_skip_ws(obj, end), *k;
+	size_t len;
+
+	if (p >= end || *p != '{') {
+		return NULL;
+	}
+	p++;
+	while (1) {
+		p = json_skip_ws(p, end);
+		if (p >= end || *p == '}') {
+			return NULL;
+		}
+		if (*p == '"') {
+			for (k = ++p; p < end && *p != '"'; p++);
+			len = p - k;
+			p++;
+		} else {
+			for (k = p; p < end && (isalnum((unsigned char) *p) || *p == '_'); p++);
+			len = p - k;
+		}
+		p = json_skip_ws(p, end);
+		if (p >= end || *p != ':') {
+			return NULL;
+		}
+		p = json_skip_ws(p + 1, end);
+		if (len == key_len && !strncmp(k, key, len)) {
+			return p;
+		}
+		p = json_skip_ws(json_skip_value(p, end), end);
+		if (p < end && *p == ',') {
+			p++;
+		}
+	}
+}
+
+static char *json_unquote(const char *p, const char *end)
+{
+	char *s, *o;
+
+	if (p >= end || *p != '"' || !(s = o = malloc(end - p))) {
+		return NULL;
+	}
+	for (p++; p < end && *p != '"'; p++) {
+		if (*p == '\\' && p + 1 < end) {
+			p++;
+			*o++ = (*p == 'n') ? '\n' : (*p == 't') ? '\t' : *p;
+		} else {
+			*o++ = *p;
+		}
+	}
+	*o = '\0';
+	return s;
+}
+
+int json_scanf(const char *str, int len, const char *fmt, ...)
+{
+	const char *end = str + len, *f = fmt, *v;
+	char key[JSON_KEY_MAX];
+	size_t key_len;
+	int n = 0;
+	va_list ap;
+
+	va_start(ap, fmt);
+	while ((f = strpbrk(f, "{,")) != NULL) {
+		for (f++; isspace((unsigned char) *f); f++);
+		for (key_len = 0; *f && *f != ':' && !isspace((unsigned char) *f) && key_len < sizeof(key) - 1; f++) {
+			key[key_len++] = *f;
+		}
+		key[key_len] = '\0';
+		if (!(f = strchr(f, '%'))) {
+			break;
+		}
+		f++;
+		v = json_find_key(str, end, key, key_len);
+		switch (*f) {
+		case 'd':
+		case 'u': {
+			int *target = va_arg(ap, int *);
+			if (v && (isdigit((unsigned char) *v) || *v == '-')) {
+				*target = (int) strtol(v, NULL, 0);
+				n++;
+			}
+			break;
+		}
+		case 'B': {
+			bool *target = va_arg(ap, bool *);
+			if (v && (!strncmp(v, "true", 4) || !strncmp(v, "false", 5))) {
+				*target = (*v == 't');
+				n++;
+			}
+			break;
+		}
+		case 'Q': {
+			char **target = va_arg(ap, char **);
+			char *s = v ? json_unquote(v, json_skip_value(v, end)) : NULL;
+			if (s) {
+				*target = s;
+				n++;
+			}
+			break;
+		}
+		default:
+			va_end(ap);
+			return n;
+		}
+	}
+	va_end(ap);
+	return n;
+}
+
+char *json_fread(const char *path)
+{
+	FILE *fp;
+	char *data = NULL;
+	long size;
+
+	if (!(fp = fopen(path, "rb"))) {
+		return NULL;
+	}
+	if (fseek(fp, 0, SEEK_END) == 0 && (size = ftell(fp)) >= 0 && fseek(fp, 0, SEEK_SET) == 0 &&
+		(data = calloc(1, size + 1)) && fread(data, 1, size, fp) != (size_t) size) {
+		free(data);
+		data = NULL;
+	}
+	fclose(fp);
+	return data;
+}
+
+/**
+ *  @brief: the elements of the array under a top level key, path ".key".
+ *          handle is where the next element starts.
+ */
+void *json_next_elem(const char *s, int len, void *handle, const char *path, int *idx, struct json_token *val)
+{
+	const char *end = s + len, *p = handle;
+
+	if (!p) {
+		if (path[0] != '.' || !(p = json_find_key(s, end, path + 1, strlen(path + 1))) || *p != '[') {
+			return NULL;
+		}
+		p++;
+		*idx = 0;
+	} else {
+		(*idx)++;
+	}
+	p = json_skip_ws(p, end);
+	if (p >= end || *p == ']') {
+		return NULL;
+	}
+	val->ptr = p;
+	val->len = json_skip_value(p, end) - p;
+	val->type = (*p == '"') ? JSON_TYPE_STRING : JSON_TYPE_NUMBER;
+	p = json_skip_ws(p + val->len, end);
+	if (p < end && *p == ',') {
+		p++;
+	}
+	return (void *) p;
+}
@@ -0,0 +1,257 @@
+/*
+ * gfxfont2bin: turn an Adafruit GFX font header into a font file for
+ * mgos_ili9341_set_font_file().
+ *
+ *   gfxfont2bin font.h [font.h ...] out.gfx
+ *
+ * The header is read as text: the first three brace blocks holding numbers
+ * are taken as the bitmap array, the glyph array and the GFXfont itself
+ * (first, last, yAdvance), the way fontconvert writes them.
+ * Each header is one range of codepoints; several of them, e.g. ASCII,
+ * Latin-1 and Cyrillic cut from the same typeface, make one sparse font.
+ */
+#include <ctype.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gfxfont.h"
+
+struct numbers {
+	long *v;
+	int n, size;
+};
+
+
+static void numbers_add(struct numbers *nums, const long v)
+{
+	if (nums->n == nums->size) {
+		nums->size = nums->size ? nums->size * 2 : 256;
+		nums->v = realloc(nums->v, nums->size * sizeof(long));
+		if (!nums->v) {
+			perror("realloc");
+			exit(1);
+		}
+	}
+	nums->v[nums->n++] = v;
+}
+
+/**
+ *  @brief: the numbers inside each top level { } block of a C source,
+ *          skipping comments, identifiers and casts
+ */
+static int read_blocks(const char *src, struct numbers *blocks, const int max)
+{
+	const char *p = src;
+	int depth = 0, count = 0;
+
+	while (*p) {
+		if ((p[0] == '/') && (p[1] == '/')) {
+			p = strchr(p, '\n');
+			if (!p) break;
+		} else if ((p[0] == '/') && (p[1] == '*')) {
+			p = strstr(p + 2, "*/");
+			if (!p) break;
+			p += 2;
+		} else if ((*p == '\'') || (*p == '"')) {
+			const char q = *p++;
+			while (*p && (*p != q)) p += (*p == '\\') ? 2 : 1;
+			if (*p) p++;
+		} else if (*p == '{') {
+			if (depth++ == 0) {
+				if (count == max) break;
+				memset(&blocks[count++], 0, sizeof(blocks[0]));
+			}
+			p++;
+		} else if (*p == '}') {
+			if (depth > 0) depth--;
+			p++;
+		} else if (isalpha((unsigned char) *p) || (*p == '_')) {
+			while (isalnum((unsigned char) *p) || (*p == '_')) p++;
+		} else if ((depth > 0) && (isdigit((unsigned char) *p) ||
+			((*p == '-') && isdigit((unsigned char) p[1])))) {
+			char *end;
+			numbers_add(&blocks[count - 1], strtol(p, &end, 0));
+			p = end;
+		} else {
+			p++;
+		}
+	}
+
+	/* blocks without numbers (e.g. a struct definition) don't count */
+	{
+		int i, j = 0;
+		for (i = 0; i < count; i++) {
+			if (blocks[i].n) {
+				blocks[j++] = blocks[i];
+			} else {
+				free(blocks[i].v);
+			}
+		}
+		return j;
+	}
+}
+
+static void put_u16(uint8_t *p, const uint32_t v)
+{
+	p[0] = v;
+	p[1] = v >> 8;
+}
+
+static void put_u32(uint8_t *p, const uint32_t v)
+{
+	p[0] = v;
+	p[1] = v >> 8;
+	p[2] = v >> 16;
+	p[3] = v >> 24;
+}
+
+static char *read_file(const char *path)
+{
+	FILE *in;
+	char *src;
+	long len;
+
+	if (!(in = fopen(path, "rb"))) {
+		perror(path);
+		return NULL;
+	}
+	fseek(in, 0, SEEK_END);
+	len = ftell(in);
+	fseek(in, 0, SEEK_SET);
+	src = calloc(1, len + 1);
+	if (!src || (fread(src, 1, len, in) != (size_t) len)) {
+		fprintf(stderr, "%s: could not read\n", path);
+		free(src);
+		src = NULL;
+	}
+	fclose(in);
+	return src;
+}
+
+struct font_range {
+	long first;
+	int count, glyph;
+};
+
+static int range_cmp(const void *a, const void *b)
+{
+	const struct font_range *ra = a, *rb = b;
+
+	return (ra->first > rb->first) - (ra->first < rb->first);
+}
+
+int main(int argc, char **argv)
+{
+	struct numbers blocks[3], bitmaps = { 0 }, glyphs = { 0 };
+	struct font_range *ranges;
+	uint8_t hdr[GFXFONT_FILE_HEADER_SIZE] = { 0 };
+	uint8_t rec[GFXFONT_FILE_GLYPH_SIZE];
+	const char *path = argv[argc - 1];
+	FILE *out;
+	char *src;
+	int nranges = argc - 2, yadvance = 0, count = 0, i, j;
+
+	if (argc < 3) {
+		fprintf(stderr, "usage: %s font.h [font.h ...] out.gfx\n", argv[0]);
+		return 1;
+	}
+
+	/* every header is one range of codepoints */
+	ranges = calloc(nranges, sizeof(*ranges));
+	for (i = 0; i < nranges; i++) {
+		const char *in = argv[i + 1];
+		long first, last;
+		int n;
+
+		if (!(src = read_file(in))) {
+			return 1;
+		}
+		if (read_blocks(src, blocks, 3) != 3 || (blocks[1].n % 6) || (blocks[2].n < 3)) {
+			fprintf(stderr, "%s: does not look like a GFX font\n", in);
+			return 1;
+		}
+		first = blocks[2].v[0];
+		last = blocks[2].v[1];
+		n = blocks[1].n / 6;
+		if (n != last - first + 1) {
+			fprintf(stderr, "%s: %d glyphs for 0x%02lx..0x%02lx\n", in, n, first, last);
+			return 1;
+		}
+
+		ranges[i].first = first;
+		ranges[i].count = n;
+		ranges[i].glyph = count;
+		for (j = 0; j < blocks[1].n; j++) {
+			numbers_add(&glyphs, blocks[1].v[j] + ((j % 6) ? 0 : bitmaps.n));
+		}
+		for (j = 0; j < blocks[0].n; j++) {
+			numbers_add(&bitmaps, blocks[0].v[j]);
+		}
+		if (blocks[2].v[2] > yadvance) {
+			yadvance = blocks[2].v[2];
+		}
+		count += n;
+		for (j = 0; j < 3; j++) {
+			free(blocks[j].v);
+		}
+		free(src);
+	}
+
+	qsort(ranges, nranges, sizeof(*ranges), range_cmp);
+	for (i = 1; i < nranges; i++) {
+		if (ranges[i].first < ranges[i - 1].first + ranges[i - 1].count) {
+			fprintf(stderr, "codepoints 0x%04lx.. are in two fonts\n", ranges[i].first);
+			return 1;
+		}
+	}
+
+	if (!(out = fopen(path, "wb"))) {
+		perror(path);
+		return 1;
+	}
+	memcpy(hdr, GFXFONT_FILE_MAGIC, 4);
+	hdr[4] = GFXFONT_FILE_VERSION;
+	/* only meaningful to version 1 readers */
+	hdr[5] = (ranges[0].first > 0xFF) ? 0xFF : ranges[0].first;
+	hdr[6] = (ranges[nranges - 1].first + ranges[nranges - 1].count - 1 > 0xFF) ? 0xFF :
+		ranges[nranges - 1].first + ranges[nranges - 1].count - 1;
+	hdr[7] = yadvance;
+	put_u16(&hdr[8], count);
+	put_u16(&hdr[10], nranges);
+	put_u32(&hdr[12], bitmaps.n);
+	fwrite(hdr, 1, sizeof(hdr), out);
+
+	for (i = 0; i < count; i++) {
+		const long *g = &glyphs.v[i * 6];
+
+		memset(rec, 0, sizeof(rec));
+		put_u32(&rec[0], g[0]);
+		rec[4] = g[1];
+		rec[5] = g[2];
+		rec[6] = g[3];
+		rec[7] = (int8_t) g[4];
+		rec[8] = (int8_t) g[5];
+		fwrite(rec, 1, sizeof(rec), out);
+	}
+	for (i = 0; i < nranges; i++) {
+		put_u32(&rec[0], ranges[i].first);
+		put_u16(&rec[4], ranges[i].count);
+		put_u16(&rec[6], ranges[i].glyph);
+		fwrite(rec, 1, GFXFONT_FILE_RANGE_SIZE, out);
+	}
+	for (i = 0; i < bitmaps.n; i++) {
+		fputc(bitmaps.v[i], out);
+	}
+	if (fclose(out)) {
+		perror(path);
+		return 1;
+	}
+
+	printf("%s: %d glyphs in %d ranges, %d bitmap bytes, %ld bytes written\n", path, count, nranges,
+		bitmaps.n, (long) (GFXFONT_FILE_HEADER_SIZE + count * GFXFONT_FILE_GLYPH_SIZE +
+		nranges * GFXFONT_FILE_RANGE_SIZE + bitmaps.n));
+	return 0;
+}
@@ -0,0 +1,9 @@
+/*
+ * Host stand-in for Mongoose OS common/queue.h, which is the BSD one.
+ */
+#ifndef _MGOS_HOST_COMMON_QUEUE_H
+#define _MGOS_HOST_COMMON_QUEUE_H
+
+#include <sys/queue.h>
+
+#endif // _MGOS_HOST_COMMON_QUEUE_H
@@ -0,0 +1,32 @@
+/*
+ * Host stand-in for the parts of frozen.h used by libs/epaper, see
+ * frozen_host.c. json_scanf() understands flat {key: %d/%u/%B/%Q} formats.
+ */
+#ifndef _MGOS_HOST_FROZEN_H
+#define _MGOS_HOST_FROZEN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+enum json_token_type {
+	JSON_TYPE_INVALID = 0,
+	JSON_TYPE_STRING,
+	JSON_TYPE_NUMBER,
+	JSON_TYPE_TRUE,
+	JSON_TYPE_FALSE,
+	JSON_TYPE_NULL,
+	JSON_TYPE_OBJECT_END,
+	JSON_TYPE_ARRAY_END,
+};
+
+struct json_token {
+	const char *ptr;
+	int len;
+	enum json_token_type type;
+};
+
+int json_scanf(const char *str, int len, const char *fmt, ...);
+char *json_fread(const char *path);
+void *json_next_elem(const char *s, int len, void *handle, const char *path, int *idx, struct json_token *val);
+
+#endif // _MGOS_HOST_FROZEN_H
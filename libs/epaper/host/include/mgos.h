@@ -0,0 +1,90 @@
+/*
+ * Host (Linux) stand-in for the parts of mgos.h used by libs/epaper.
+ * Only what the library needs is declared; see mgos_host.c.
+ */
+#ifndef _MGOS_HOST_MGOS_H
+#define _MGOS_HOST_MGOS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+enum cs_log_level {
+	LL_NONE				= -1,
+	LL_ERROR			= 0,
+	LL_WARN				= 1,
+	LL_INFO				= 2,
+	LL_DEBUG			= 3,
+	LL_VERBOSE_DEBUG	= 4,
+};
+
+extern enum cs_log_level mgos_host_log_level;
+void mgos_host_log(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+#define LOG(l, x)								\
+	do {										\
+		if ((l) <= mgos_host_log_level) {		\
+			fprintf(stderr, "%-24s ", __func__);\
+			mgos_host_log x;					\
+		}										\
+	} while (0)
+
+/* Timers and callbacks */
+typedef uintptr_t mgos_timer_id;
+typedef void (*timer_callback)(void *arg);
+#define MGOS_TIMER_REPEAT	1
+
+mgos_timer_id mgos_set_timer(int msecs, int flags, timer_callback cb, void *cb_arg);
+void mgos_clear_timer(mgos_timer_id id);
+
+typedef void (*mgos_cb_t)(void *arg);
+bool mgos_invoke_cb(mgos_cb_t cb, void *arg, bool from_isr);
+
+void mgos_msleep(uint32_t msecs);
+void mgos_usleep(uint32_t usecs);
+double mgos_uptime(void);
+int64_t mgos_uptime_micros(void);
+
+/* GPIO */
+enum mgos_gpio_mode {
+	MGOS_GPIO_MODE_INPUT	= 0,
+	MGOS_GPIO_MODE_OUTPUT	= 1,
+};
+
+enum mgos_gpio_pull_type {
+	MGOS_GPIO_PULL_NONE	= 0,
+	MGOS_GPIO_PULL_UP	= 1,
+	MGOS_GPIO_PULL_DOWN	= 2,
+};
+
+enum mgos_gpio_int_mode {
+	MGOS_GPIO_INT_NONE		= 0,
+	MGOS_GPIO_INT_EDGE_POS	= 1,
+	MGOS_GPIO_INT_EDGE_NEG	= 2,
+	MGOS_GPIO_INT_EDGE_ANY	= 3,
+	MGOS_GPIO_INT_LEVEL_HI	= 4,
+	MGOS_GPIO_INT_LEVEL_LO	= 5,
+};
+
+typedef void (*mgos_gpio_int_handler_f)(int pin, void *arg);
+
+bool mgos_gpio_set_mode(int pin, enum mgos_gpio_mode mode);
+bool mgos_gpio_set_pull(int pin, enum mgos_gpio_pull_type pull);
+bool mgos_gpio_read(int pin);
+void mgos_gpio_write(int pin, bool level);
+bool mgos_gpio_set_int_handler(int pin, enum mgos_gpio_int_mode mode, mgos_gpio_int_handler_f cb, void *arg);
+bool mgos_gpio_enable_int(int pin);
+bool mgos_gpio_disable_int(int pin);
+
+enum mgos_app_init_result {
+	MGOS_APP_INIT_SUCCESS	= 0,
+	MGOS_APP_INIT_ERROR		= -2,
+};
+
+/* Runs pending callbacks, interrupts and timers for ms of simulated time */
+void mgos_host_run_for(const int ms);
+
+#endif // _MGOS_HOST_MGOS_H
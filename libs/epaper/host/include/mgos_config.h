@@ -0,0 +1,32 @@
+/*
+ * Host (Linux) stand-in for the generated mgos_config.h.
+ * Values come from mgos_host_config, defaults match libs/epaper/mos.yml.
+ */
+#ifndef _MGOS_HOST_MGOS_CONFIG_H
+#define _MGOS_HOST_MGOS_CONFIG_H
+
+struct mgos_host_config {
+	int dc_pin;
+	int cs_pin;
+	int busy_pin;
+	int reset_pin;
+	int size_x;
+	int size_y;
+	int rotation;
+	int glyph_cache_size;
+	int font_cache_size;
+};
+
+extern struct mgos_host_config mgos_host_config;
+
+static inline int mgos_sys_config_get_epaper_dc_pin(void) { return mgos_host_config.dc_pin; }
+static inline int mgos_sys_config_get_epaper_cs_pin(void) { return mgos_host_config.cs_pin; }
+static inline int mgos_sys_config_get_epaper_busy_pin(void) { return mgos_host_config.busy_pin; }
+static inline int mgos_sys_config_get_epaper_reset_pin(void) { return mgos_host_config.reset_pin; }
+static inline int mgos_sys_config_get_epaper_size_x(void) { return mgos_host_config.size_x; }
+static inline int mgos_sys_config_get_epaper_size_y(void) { return mgos_host_config.size_y; }
+static inline int mgos_sys_config_get_epaper_rotation(void) { return mgos_host_config.rotation; }
+static inline int mgos_sys_config_get_epaper_glyph_cache_size(void) { return mgos_host_config.glyph_cache_size; }
+static inline int mgos_sys_config_get_epaper_font_cache_size(void) { return mgos_host_config.font_cache_size; }
+
+#endif // _MGOS_HOST_MGOS_CONFIG_H
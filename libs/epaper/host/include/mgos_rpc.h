@@ -0,0 +1,36 @@
+/*
+ * Host stand-in for the parts of mgos_rpc.h used by libs/epaper.
+ * Handlers are called with mgos_host_rpc_call(), see mgos_host.c.
+ */
+#ifndef _MGOS_HOST_MGOS_RPC_H
+#define _MGOS_HOST_MGOS_RPC_H
+
+#include <stddef.h>
+
+#include "frozen/frozen.h"
+
+struct mg_str {
+	const char *p;
+	size_t len;
+};
+
+struct mg_rpc;
+struct mg_rpc_frame_info;
+
+struct mg_rpc_request_info {
+	const char *method;
+	const char *args_fmt;
+	char *resp;			// the response, for mgos_host_rpc_call()
+	size_t resp_size;
+};
+
+typedef void (*mg_handler_cb_t)(struct mg_rpc_request_info *ri, void *cb_arg, struct mg_rpc_frame_info *fi, struct mg_str args);
+
+struct mg_rpc *mgos_rpc_get_global(void);
+void mg_rpc_add_handler(struct mg_rpc *c, const char *method, const char *args_fmt, mg_handler_cb_t cb, void *cb_arg);
+bool mg_rpc_send_responsef(struct mg_rpc_request_info *ri, const char *result_json_fmt, ...);
+
+/* Calls the handler of method with the JSON args, the response goes into resp */
+bool mgos_host_rpc_call(const char *method, const char *args, char *resp, size_t resp_size);
+
+#endif // _MGOS_HOST_MGOS_RPC_H
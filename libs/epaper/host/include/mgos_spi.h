@@ -0,0 +1,35 @@
+/*
+ * Host (Linux) stand-in for mgos_spi.h.
+ * Transactions are handed to the SSD1608 emulator, see ssd1608_emu.c.
+ */
+#ifndef _MGOS_HOST_MGOS_SPI_H
+#define _MGOS_HOST_MGOS_SPI_H
+
+#include "mgos.h"
+
+struct mgos_spi;
+
+struct mgos_spi_txn {
+	int cs;
+	int mode;
+	int freq;
+	union {
+		struct {
+			size_t tx_len;
+			const void *tx_data;
+			size_t dummy_len;
+			size_t rx_len;
+			void *rx_data;
+		} hd;
+		struct {
+			size_t len;
+			const void *tx_data;
+			void *rx_data;
+		} fd;
+	};
+};
+
+struct mgos_spi *mgos_spi_get_global(void);
+bool mgos_spi_run_txn(struct mgos_spi *spi, bool full_duplex, const struct mgos_spi_txn *txn);
+
+#endif // _MGOS_HOST_MGOS_SPI_H
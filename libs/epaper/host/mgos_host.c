@@ -0,0 +1,460 @@
+/*
+ * Fake Mongoose OS backend for the host build of libs/epaper.
+ *
+ * Time is simulated: mgos_msleep() advances the clock instead of sleeping,
+ * so a blocking BUSY wait costs nothing on the host but still shows up in
+ * the emulator's busy time. GPIO and SPI traffic is handed to the SSD1608
+ * emulator.
+ */
+#include <ctype.h>
+#include <stdarg.h>
+
+#include "mgos.h"
+#include "mgos_config.h"
+#include "mgos_spi.h"
+#include "mgos_rpc.h"
+#include "ssd1608_emu.h"
+
+#define HOST_MAX_TIMERS		32
+#define HOST_MAX_CBS		32
+#define HOST_MAX_GPIO		40
+#define HOST_MAX_RPC		8
+
+enum cs_log_level mgos_host_log_level = LL_WARN;
+
+struct mgos_host_config mgos_host_config = {
+	.dc_pin = 22,
+	.cs_pin = 5,
+	.busy_pin = 21,
+	.reset_pin = 13,
+	.size_x = 200,
+	.size_y = 200,
+	.rotation = 0,
+	.glyph_cache_size = 4096,
+	.font_cache_size = 2048,
+};
+
+static int64_t _now_us = 0;
+
+static struct {
+	mgos_timer_id id;
+	int64_t due;
+	int period_ms;
+	bool repeat;
+	timer_callback cb;
+	void *arg;
+} _timers[HOST_MAX_TIMERS];
+static mgos_timer_id _next_timer_id = 1;
+
+static struct {
+	mgos_cb_t cb;
+	void *arg;
+} _cbs[HOST_MAX_CBS];
+static int _ncbs = 0;
+
+static struct {
+	bool level;
+	enum mgos_gpio_int_mode int_mode;
+	mgos_gpio_int_handler_f int_cb;
+	void *int_arg;
+	bool int_enabled;
+} _gpio[HOST_MAX_GPIO];
+
+static bool _busy_level = false;
+
+static struct {
+	const char *method;
+	const char *args_fmt;
+	mg_handler_cb_t cb;
+	void *cb_arg;
+} _rpc[HOST_MAX_RPC];
+
+
+void mgos_host_log(const char *fmt, ...)
+{
+	va_list ap;
+
+	va_start(ap, fmt);
+	vfprintf(stderr, fmt, ap);
+	va_end(ap);
+	fputc('\n', stderr);
+}
+
+
+// --------------------------------------------------------------------------------------
+// Time
+
+void mgos_msleep(uint32_t msecs)
+{
+	_now_us += (int64_t)msecs * 1000;
+}
+
+void mgos_usleep(uint32_t usecs)
+{
+	_now_us += usecs;
+}
+
+double mgos_uptime(void)
+{
+	return _now_us / 1000000.0;
+}
+
+int64_t mgos_uptime_micros(void)
+{
+	return _now_us;
+}
+
+
+// --------------------------------------------------------------------------------------
+// Timers and callbacks
+
+mgos_timer_id mgos_set_timer(int msecs, int flags, timer_callback cb, void *cb_arg)
+{
+	int i;
+
+	for (i=0; i<HOST_MAX_TIMERS; i++) {
+		if (_timers[i].id == 0) {
+			_timers[i].id = _next_timer_id++;
+			_timers[i].due = _now_us + (int64_t)msecs * 1000;
+			_timers[i].period_ms = msecs;
+			_timers[i].repeat = (flags & MGOS_TIMER_REPEAT);
+			_timers[i].cb = cb;
+			_timers[i].arg = cb_arg;
+			return _timers[i].id;
+		}
+	}
+	LOG(LL_ERROR, ("Out of timers"));
+
+	return 0;
+}
+
+void mgos_clear_timer(mgos_timer_id id)
+{
+	int i;
+
+	for (i=0; i<HOST_MAX_TIMERS; i++) {
+		if (id && (_timers[i].id == id)) {
+			_timers[i].id = 0;
+		}
+	}
+}
+
+bool mgos_invoke_cb(mgos_cb_t cb, void *arg, bool from_isr)
+{
+	if (_ncbs >= HOST_MAX_CBS) {
+		return false;
+	}
+	_cbs[_ncbs].cb = cb;
+	_cbs[_ncbs].arg = arg;
+	_ncbs++;
+	(void) from_isr;
+
+	return true;
+}
+
+
+// --------------------------------------------------------------------------------------
+// GPIO
+
+static bool host_valid_pin(const int pin)
+{
+	return (pin >= 0) && (pin < HOST_MAX_GPIO);
+}
+
+bool mgos_gpio_set_mode(int pin, enum mgos_gpio_mode mode)
+{
+	(void) mode;
+	return host_valid_pin(pin);
+}
+
+bool mgos_gpio_set_pull(int pin, enum mgos_gpio_pull_type pull)
+{
+	(void) pull;
+	return host_valid_pin(pin);
+}
+
+bool mgos_gpio_read(int pin)
+{
+	if (pin == mgos_host_config.busy_pin) {
+		return ssd1608_emu_busy();
+	}
+	return host_valid_pin(pin) ? _gpio[pin].level : false;
+}
+
+void mgos_gpio_write(int pin, bool level)
+{
+	if (!host_valid_pin(pin)) {
+		return;
+	}
+
+	if (pin == mgos_host_config.dc_pin) {
+		ssd1608_emu_dc(level);
+	} else if ((pin == mgos_host_config.reset_pin) && !_gpio[pin].level && level) {
+		ssd1608_emu_hw_reset();
+	}
+	_gpio[pin].level = level;
+}
+
+bool mgos_gpio_set_int_handler(int pin, enum mgos_gpio_int_mode mode, mgos_gpio_int_handler_f cb, void *arg)
+{
+	if (!host_valid_pin(pin)) {
+		return false;
+	}
+	_gpio[pin].int_mode = mode;
+	_gpio[pin].int_cb = cb;
+	_gpio[pin].int_arg = arg;
+
+	return true;
+}
+
+bool mgos_gpio_enable_int(int pin)
+{
+	if (!host_valid_pin(pin)) {
+		return false;
+	}
+	_gpio[pin].int_enabled = true;
+	return true;
+}
+
+bool mgos_gpio_disable_int(int pin)
+{
+	if (!host_valid_pin(pin)) {
+		return false;
+	}
+	_gpio[pin].int_enabled = false;
+	return true;
+}
+
+
+// --------------------------------------------------------------------------------------
+// SPI
+
+struct mgos_spi *mgos_spi_get_global(void)
+{
+	static int dummy;
+
+	return (struct mgos_spi *) &dummy;
+}
+
+bool mgos_spi_run_txn(struct mgos_spi *spi, bool full_duplex, const struct mgos_spi_txn *txn)
+{
+	if (!spi || !txn) {
+		return false;
+	}
+	if (full_duplex) {
+		ssd1608_emu_spi(txn->fd.tx_data, txn->fd.len);
+	} else {
+		ssd1608_emu_spi(txn->hd.tx_data, txn->hd.tx_len);
+	}
+
+	return true;
+}
+
+
+// --------------------------------------------------------------------------------------
+// RPC
+
+struct mg_rpc *mgos_rpc_get_global(void)
+{
+	static int dummy;
+
+	return (struct mg_rpc *) &dummy;
+}
+
+void mg_rpc_add_handler(struct mg_rpc *c, const char *method, const char *args_fmt, mg_handler_cb_t cb, void *cb_arg)
+{
+	int i;
+
+	for (i=0; i<HOST_MAX_RPC; i++) {
+		if (!_rpc[i].method || !strcmp(_rpc[i].method, method)) {
+			_rpc[i].method = method;
+			_rpc[i].args_fmt = args_fmt;
+			_rpc[i].cb = cb;
+			_rpc[i].cb_arg = cb_arg;
+			return;
+		}
+	}
+	LOG(LL_ERROR, ("Out of RPC handlers"));
+	(void) c;
+}
+
+/**
+ *  @brief: printf the response, quoting the bare keys like json_printf() does
+ */
+bool mg_rpc_send_responsef(struct mg_rpc_request_info *ri, const char *result_json_fmt, ...)
+{
+	char buf[1024];
+	const char *p;
+	size_t o = 0;
+	bool in_string = false;
+	va_list ap;
+
+	va_start(ap, result_json_fmt);
+	vsnprintf(buf, sizeof(buf), result_json_fmt, ap);
+	va_end(ap);
+
+	for (p = buf; *p && (o + 3 < ri->resp_size); p++) {
+		size_t n = 0;
+
+		if (*p == '"') {
+			in_string = !in_string;
+		}
+		if (!in_string && (isalpha((unsigned char) *p) || *p == '_') && (p == buf || !isalnum((unsigned char) p[-1]))) {
+			while (isalnum((unsigned char) p[n]) || p[n] == '_') {
+				n++;
+			}
+			if (p[n] == ':' && (o + n + 3 < ri->resp_size)) {
+				ri->resp[o++] = '"';
+				memcpy(&ri->resp[o], p, n);
+				o += n;
+				ri->resp[o++] = '"';
+				p += n - 1;
+				continue;
+			}
+		}
+		ri->resp[o++] = *p;
+	}
+	ri->resp[o] = '\0';
+
+	return true;
+}
+
+bool mgos_host_rpc_call(const char *method, const char *args, char *resp, size_t resp_size)
+{
+	struct mg_rpc_request_info ri;
+	struct mg_str a;
+	int i;
+
+	for (i=0; i<HOST_MAX_RPC; i++) {
+		if (_rpc[i].method && !strcmp(_rpc[i].method, method)) {
+			ri.method = method;
+			ri.args_fmt = _rpc[i].args_fmt;
+			ri.resp = resp;
+			ri.resp_size = resp_size;
+			resp[0] = '\0';
+			a.p = args;
+			a.len = strlen(args);
+			_rpc[i].cb(&ri, _rpc[i].cb_arg, NULL, a);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+// --------------------------------------------------------------------------------------
+// Event loop
+
+/**
+ *  @brief: Deliver a BUSY edge to its interrupt handler, if armed
+ */
+static bool host_poll_busy(void)
+{
+	int pin = mgos_host_config.busy_pin;
+	bool level = ssd1608_emu_busy();
+	bool fire = false;
+
+	if (level != _busy_level) {
+		if (_gpio[pin].int_enabled && _gpio[pin].int_cb) {
+			switch (_gpio[pin].int_mode) {
+			case MGOS_GPIO_INT_EDGE_NEG:
+				fire = !level;
+				break;
+			case MGOS_GPIO_INT_EDGE_POS:
+				fire = level;
+				break;
+			case MGOS_GPIO_INT_EDGE_ANY:
+				fire = true;
+				break;
+			default:
+				break;
+			}
+		}
+		_busy_level = level;
+	}
+	if (fire) {
+		_gpio[pin].int_cb(pin, _gpio[pin].int_arg);
+	}
+
+	return fire;
+}
+
+static bool host_run_cbs(void)
+{
+	int i, n = _ncbs;
+
+	if (n == 0) {
+		return false;
+	}
+	for (i=0; i<n; i++) {
+		_cbs[i].cb(_cbs[i].arg);
+	}
+	memmove(&_cbs[0], &_cbs[n], (_ncbs - n) * sizeof(_cbs[0]));
+	_ncbs -= n;
+
+	return true;
+}
+
+static bool host_run_timers(void)
+{
+	int i;
+	bool ran = false;
+
+	for (i=0; i<HOST_MAX_TIMERS; i++) {
+		if (_timers[i].id && (_timers[i].due <= _now_us)) {
+			timer_callback cb = _timers[i].cb;
+			void *arg = _timers[i].arg;
+
+			if (_timers[i].repeat) {
+				_timers[i].due += (int64_t)_timers[i].period_ms * 1000;
+			} else {
+				_timers[i].id = 0;
+			}
+			cb(arg);
+			ran = true;
+		}
+	}
+
+	return ran;
+}
+
+/**
+ *  @brief: Time of the next thing that will happen, or end if nothing does
+ */
+static int64_t host_next_event(const int64_t end)
+{
+	int i;
+	int64_t next = end;
+
+	for (i=0; i<HOST_MAX_TIMERS; i++) {
+		if (_timers[i].id && (_timers[i].due < next)) {
+			next = _timers[i].due;
+		}
+	}
+	if (ssd1608_emu_busy() && (ssd1608_emu_busy_until() < next)) {
+		next = ssd1608_emu_busy_until();
+	}
+
+	return next;
+}
+
+void mgos_host_run_for(const int ms)
+{
+	int64_t end = _now_us + (int64_t)ms * 1000;
+
+	for (;;) {
+		bool ran = false;
+
+		ran |= host_run_cbs();
+		ran |= host_poll_busy();
+		ran |= host_run_timers();
+		if (ran) {
+			continue;
+		}
+		if (_now_us >= end) {
+			break;
+		}
+		_now_us = host_next_event(end);
+	}
+}
@@ -0,0 +1,360 @@
+/*
+ * Host-side SSD1608 (IL3829) controller emulator.
+ *
+ * BUSY timing model: the last 10 bytes of the 30 byte LUT hold 20 phase
+ * lengths (one nibble each, in frames). A refresh keeps BUSY high for the
+ * sum of those frames. One frame scans all gate lines plus the dummy
+ * lines, each line taking (gate_time + 1) * 8 us. It is an approximation,
+ * good enough to compare update strategies against each other.
+ */
+#include "mgos.h"
+#include "epaper.h"
+#include "ssd1608_emu.h"
+
+#define EMU_MAX_PARAMS		32
+#define EMU_LUT_SIZE		30
+#define EMU_RESET_BUSY_US	1000
+
+static struct {
+	int width;					// pixels
+	int height;
+	int bytes_per_row;
+
+	int dc;
+	uint8_t cmd;
+	uint8_t param[EMU_MAX_PARAMS];
+	int nparam;
+
+	int gate_lines;
+	uint8_t dummy_line;
+	uint8_t gate_time;
+	uint8_t entry_mode;
+	uint8_t update_ctrl2;
+	uint8_t lut[EMU_LUT_SIZE];
+	bool sleeping;
+
+	int x_start, x_end;			// bytes
+	int y_start, y_end;
+	int x_cnt, y_cnt;
+
+	uint8_t *ram[2];
+	int bank;					// bank WRITE_RAM goes to
+	uint8_t *display;			// what is on glass
+
+	int64_t busy_until;
+
+	struct ssd1608_emu_stats stats;
+} emu;
+
+
+/**
+ *  @brief: Registers back to their power-on values, RAM is kept
+ */
+static void emu_reset_registers(void)
+{
+	emu.cmd = 0;
+	emu.nparam = 0;
+	emu.gate_lines = emu.height;
+	emu.dummy_line = 0x1A;
+	emu.gate_time = 0x08;
+	emu.entry_mode = 0x03;
+	emu.update_ctrl2 = 0;
+	memset(emu.lut, 0, sizeof(emu.lut));
+	emu.sleeping = false;
+	emu.x_start = 0;
+	emu.x_end = emu.bytes_per_row - 1;
+	emu.y_start = 0;
+	emu.y_end = emu.height - 1;
+	emu.x_cnt = 0;
+	emu.y_cnt = 0;
+}
+
+void ssd1608_emu_init(const int width, const int height)
+{
+	int i, size;
+
+	emu.width = width;
+	emu.height = height;
+	emu.bytes_per_row = (width + 7) / 8;
+	size = emu.bytes_per_row * height;
+
+	for (i=0; i<2; i++) {
+		free(emu.ram[i]);
+		emu.ram[i] = malloc(size);
+		memset(emu.ram[i], 0xFF, size);
+	}
+	free(emu.display);
+	emu.display = malloc(size);
+	memset(emu.display, 0xFF, size);
+	emu.bank = 0;
+	emu.dc = -1;
+	emu.busy_until = 0;
+
+	emu_reset_registers();
+	ssd1608_emu_clear_stats();
+}
+
+void ssd1608_emu_hw_reset(void)
+{
+	emu_reset_registers();
+	emu.bank = 0;
+	emu.busy_until = mgos_uptime_micros() + EMU_RESET_BUSY_US;
+}
+
+bool ssd1608_emu_busy(void)
+{
+	return (mgos_uptime_micros() < emu.busy_until);
+}
+
+int64_t ssd1608_emu_busy_until(void)
+{
+	return emu.busy_until;
+}
+
+void ssd1608_emu_dc(const int level)
+{
+	if ((emu.dc != -1) && (emu.dc != level)) {
+		emu.stats.dc_toggles++;
+	}
+	emu.dc = level;
+}
+
+
+/**
+ *  @brief: Keep BUSY high for us, counting it into the stats
+ */
+static void emu_set_busy(const int64_t us)
+{
+	int64_t now = mgos_uptime_micros();
+
+	emu.busy_until = now + us;
+	emu.stats.busy_us += us;
+}
+
+/**
+ *  @brief: Refresh duration from the LUT phase lengths
+ */
+static int64_t emu_refresh_us(void)
+{
+	int i, frames = 0;
+	int64_t line_us = ((emu.gate_time & 0x0F) + 1) * 8;
+
+	for (i=20; i<EMU_LUT_SIZE; i++) {
+		frames += (emu.lut[i] >> 4) + (emu.lut[i] & 0x0F);
+	}
+
+	return (int64_t)frames * (emu.gate_lines + emu.dummy_line) * line_us;
+}
+
+static void emu_write_ram(const uint8_t data)
+{
+	if ((emu.x_cnt < emu.bytes_per_row) && (emu.y_cnt < emu.height)) {
+		emu.ram[emu.bank][emu.y_cnt * emu.bytes_per_row + emu.x_cnt] = data;
+	}
+	emu.stats.ram_bytes++;
+
+	/* AM = 0: the X counter moves first, then Y */
+	if (emu.entry_mode & 0x01) {
+		if (++emu.x_cnt > emu.x_end) {
+			emu.x_cnt = emu.x_start;
+		} else {
+			return;
+		}
+	} else {
+		if (--emu.x_cnt < emu.x_start) {
+			emu.x_cnt = emu.x_end;
+		} else {
+			return;
+		}
+	}
+
+	if (emu.entry_mode & 0x02) {
+		if (++emu.y_cnt > emu.y_end) {
+			emu.y_cnt = emu.y_start;
+		}
+	} else {
+		if (--emu.y_cnt < emu.y_start) {
+			emu.y_cnt = emu.y_end;
+		}
+	}
+}
+
+static void emu_activate(void)
+{
+	int size = emu.bytes_per_row * emu.height;
+
+	if (!(emu.update_ctrl2 & 0x04)) {
+		/* clock / analog only, nothing shown */
+		emu_set_busy(EMU_RESET_BUSY_US);
+		return;
+	}
+
+	memcpy(emu.display, emu.ram[emu.bank], size);
+	emu.bank ^= 1;
+	emu.stats.refreshes++;
+	emu_set_busy(emu_refresh_us());
+}
+
+static void emu_command(const uint8_t cmd)
+{
+	emu.cmd = cmd;
+	emu.nparam = 0;
+	emu.stats.commands++;
+
+	switch (cmd) {
+	case MASTER_ACTIVATION:
+		emu_activate();
+		break;
+	case SW_RESET:
+		emu_reset_registers();
+		emu_set_busy(EMU_RESET_BUSY_US);
+		break;
+	case DEEP_SLEEP_MODE:
+		emu.sleeping = true;
+		break;
+	case WRITE_RAM:
+	case TERMINATE_FRAME_READ_WRITE:
+	case DRIVER_OUTPUT_CONTROL:
+	case BOOSTER_SOFT_START_CONTROL:
+	case GATE_SCAN_START_POSITION:
+	case DATA_ENTRY_MODE_SETTING:
+	case TEMPERATURE_SENSOR_CONTROL:
+	case DISPLAY_UPDATE_CONTROL_1:
+	case DISPLAY_UPDATE_CONTROL_2:
+	case WRITE_VCOM_REGISTER:
+	case WRITE_LUT_REGISTER:
+	case SET_DUMMY_LINE_PERIOD:
+	case SET_GATE_TIME:
+	case BORDER_WAVEFORM_CONTROL:
+	case SET_RAM_X_ADDRESS_START_END_POSITION:
+	case SET_RAM_Y_ADDRESS_START_END_POSITION:
+	case SET_RAM_X_ADDRESS_COUNTER:
+	case SET_RAM_Y_ADDRESS_COUNTER:
+		break;
+	default:
+		emu.stats.unknown_commands++;
+		LOG(LL_WARN, ("Unknown command 0x%02x", cmd));
+		break;
+	}
+}
+
+static void emu_data(const uint8_t data)
+{
+	uint8_t *p = emu.param;
+
+	if (emu.cmd == WRITE_RAM) {
+		emu_write_ram(data);
+		return;
+	}
+
+	if (emu.nparam < EMU_MAX_PARAMS) {
+		p[emu.nparam] = data;
+	}
+	emu.nparam++;
+
+	switch (emu.cmd) {
+	case DRIVER_OUTPUT_CONTROL:
+		if (emu.nparam == 2) {
+			emu.gate_lines = (p[0] | (p[1] << 8)) + 1;
+		}
+		break;
+	case DATA_ENTRY_MODE_SETTING:
+		emu.entry_mode = p[0] & 0x07;
+		break;
+	case DISPLAY_UPDATE_CONTROL_2:
+		emu.update_ctrl2 = p[0];
+		break;
+	case WRITE_LUT_REGISTER:
+		if (emu.nparam <= EMU_LUT_SIZE) {
+			emu.lut[emu.nparam - 1] = data;
+		}
+		break;
+	case SET_DUMMY_LINE_PERIOD:
+		emu.dummy_line = p[0] & 0x7F;
+		break;
+	case SET_GATE_TIME:
+		emu.gate_time = p[0];
+		break;
+	case SET_RAM_X_ADDRESS_START_END_POSITION:
+		if (emu.nparam == 2) {
+			emu.x_start = p[0] & 0x1F;
+			emu.x_end = p[1] & 0x1F;
+		}
+		break;
+	case SET_RAM_Y_ADDRESS_START_END_POSITION:
+		if (emu.nparam == 4) {
+			emu.y_start = p[0] | ((p[1] & 0x01) << 8);
+			emu.y_end = p[2] | ((p[3] & 0x01) << 8);
+		}
+		break;
+	case SET_RAM_X_ADDRESS_COUNTER:
+		emu.x_cnt = p[0] & 0x1F;
+		break;
+	case SET_RAM_Y_ADDRESS_COUNTER:
+		if (emu.nparam == 2) {
+			emu.y_cnt = p[0] | ((p[1] & 0x01) << 8);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+void ssd1608_emu_spi(const uint8_t *data, const size_t len)
+{
+	size_t i;
+
+	emu.stats.spi_txns++;
+	emu.stats.spi_bytes += len;
+
+	if (ssd1608_emu_busy()) {
+		emu.stats.busy_violations += len;
+	}
+	if (emu.sleeping) {
+		return;
+	}
+
+	for (i=0; i<len; i++) {
+		if (emu.dc == 0) {
+			emu_command(data[i]);
+		} else {
+			emu_data(data[i]);
+		}
+	}
+}
+
+const struct ssd1608_emu_stats *ssd1608_emu_get_stats(void)
+{
+	return &emu.stats;
+}
+
+void ssd1608_emu_clear_stats(void)
+{
+	memset(&emu.stats, 0, sizeof(emu.stats));
+}
+
+const uint8_t *ssd1608_emu_get_display(void)
+{
+	return emu.display;
+}
+
+/**
+ *  @brief: Write what is on glass as a binary PBM, black pixels are 1 there
+ */
+bool ssd1608_emu_write_pbm(const char *fn)
+{
+	FILE *fp;
+	int i, size = emu.bytes_per_row * emu.height;
+
+	if (!(fp = fopen(fn, "wb"))) {
+		LOG(LL_ERROR, ("%s: could not open for writing", fn));
+		return false;
+	}
+	fprintf(fp, "P4\n%d %d\n", emu.bytes_per_row * 8, emu.height);
+	for (i=0; i<size; i++) {
+		fputc(emu.display[i] ^ 0xFF, fp);
+	}
+	fclose(fp);
+
+	return true;
+}
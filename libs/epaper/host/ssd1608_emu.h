@@ -0,0 +1,39 @@
+/*
+ * Host-side SSD1608 (IL3829) controller emulator.
+ * Decodes the command stream coming out of libs/epaper, keeps both RAM
+ * banks and models BUSY timing from the loaded LUT.
+ */
+#ifndef _SSD1608_EMU_H
+#define _SSD1608_EMU_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+struct ssd1608_emu_stats {
+	uint32_t spi_txns;			// SPI transactions
+	uint32_t spi_bytes;			// bytes over SPI, commands and data
+	uint32_t dc_toggles;		// D/C level changes
+	uint32_t commands;			// command bytes
+	uint32_t ram_bytes;			// bytes written to RAM with WRITE_RAM
+	uint32_t refreshes;			// MASTER_ACTIVATION with a display update
+	uint32_t busy_violations;	// bytes sent while BUSY was high
+	uint32_t unknown_commands;
+	uint64_t busy_us;			// simulated time BUSY was high
+};
+
+void ssd1608_emu_init(const int width, const int height);
+
+void ssd1608_emu_hw_reset(void);
+void ssd1608_emu_dc(const int level);
+void ssd1608_emu_spi(const uint8_t *data, const size_t len);
+bool ssd1608_emu_busy(void);
+int64_t ssd1608_emu_busy_until(void);
+
+const struct ssd1608_emu_stats *ssd1608_emu_get_stats(void);
+void ssd1608_emu_clear_stats(void);
+
+const uint8_t *ssd1608_emu_get_display(void);
+bool ssd1608_emu_write_pbm(const char *fn);
+
+#endif // _SSD1608_EMU_H
@@ -27,6 +27,8 @@
 #ifndef _MGOS_LIBS_EPAPER_H
 #define _MGOS_LIBS_EPAPER_H
 
+#include "epdpaint.h"
+
 enum epaper_update_type_t {
 	FULL_UPDATE		= 0,
 	PARTIAL_UPDATE	= 1,
@@ -56,10 +58,29 @@ enum epaper_update_type_t {
 #define TERMINATE_FRAME_READ_WRITE                  0xFF
 
 
+struct mgos_epd_stats {
+	uint32_t spi_txns;			// SPI transactions
+	uint32_t spi_bytes;			// bytes sent, commands and data
+	uint32_t dc_toggles;		// D/C line level changes
+	uint32_t busy_wait_ms;		// time blocked in mgos_epd_wait_idle()
+	uint32_t full_refreshes;
+	uint32_t partial_refreshes;
+	uint32_t last_refresh_ms;	// first invalidate -> controller idle
+	uint32_t max_refresh_ms;
+	uint32_t total_refresh_ms;
+};
+
+typedef void (*mgos_epd_idle_cb_t)(void *arg);
+typedef void (*mgos_epd_update_cb_t)(void *arg);
+typedef void (*mgos_epd_row_cb_t)(const int row, uint8_t *buf, void *arg);
+
+
 void mgos_epd_demo(void);
 
 int mgos_epd_reset(void);
+bool mgos_epd_is_busy(void);
 void mgos_epd_wait_idle(void);
+bool mgos_epd_wait_idle_async(mgos_epd_idle_cb_t cb, void *arg);
 void mgos_epd_sleep(void);
 
 void mgos_epd_clear_frame_memory(const uint8_t color);
@@ -74,11 +95,32 @@ bool mgos_epd_display_init(enum epaper_update_type_t type);
 
 
 void mgos_epd_pushFrameBuffer(const uint8_t* image_buffer, const int x, const int y, const int image_width, const int image_height);
+void mgos_epd_pushFrameBufferStride(const uint8_t* image_buffer, const int stride, const int x, const int y, const int image_width, const int image_height);
+void mgos_epd_pushFrameBufferRows(const int x, const int y, const int image_width, const int image_height, mgos_epd_row_cb_t cb, void *arg);
+void mgos_epd_pushFrameBufferRotated(const uint8_t* image_buffer, const int image_width, const int image_height, const enum mgos_epd_rotate_t rotate, const int x, const int y);
+void mgos_epd_set_push_clip(const int x, const int y, const int width, const int height);
+void mgos_epd_clear_push_clip(void);
+bool mgos_epd_get_push_clip(int *x, int *y, int *width, int *height);
 void mgos_epd_pushFrameBufferRel(const uint8_t* image_buffer, const int x, const int y, const int image_width, const int image_height);
 
+bool mgos_epd_update_async(const uint8_t* image_buffer, const int x, const int y, const int image_width, const int image_height, mgos_epd_update_cb_t cb, void *arg);
+bool mgos_epd_display_frame_async(mgos_epd_update_cb_t cb, void *arg);
+bool mgos_epd_async_in_progress(void);
+
 void mgos_epdUpdateNeeded(void);
+bool mgos_epdIsUpdateNeeded(void);
 void mgos_epdUpdate(void);
 
+int mgos_epd_push_diff(const uint8_t *frame);
+void mgos_epd_diff_reset(void);
+
+int mgos_epd_get_ram_bank(void);
+uint32_t mgos_epd_get_ram_epoch(void);
+
+const struct mgos_epd_stats *mgos_epd_get_stats(void);
+void mgos_epd_clear_stats(void);
+bool mgos_epd_rpc_init(void);
+
 
 #endif		// _MGOS_LIBS_EPAPER_H
 
@@ -37,6 +37,16 @@ enum mgos_epd_rotate_t {
 };
 // Display orientation
 
+// Raster operations for mgos_epd_blit(), on the raw frame buffer bits
+enum mgos_epd_rop_t {
+	EPD_ROP_COPY = 0,		// dst = src
+	EPD_ROP_OR = 1,			// dst = dst | src
+	EPD_ROP_AND = 2,		// dst = dst & src
+	EPD_ROP_XOR = 3,		// dst = dst ^ src
+	EPD_ROP_NOT = 4,		// dst = ~src
+	EPD_ROP_ANDNOT = 5,		// dst = dst & ~src
+};
+
 #define swap(a, b) { int t=a; a=b; b=t; }
 
 // Color inverse. 1 or 0 = set or reset a bit if set a colored pixel
@@ -44,6 +54,8 @@ enum mgos_epd_rotate_t {
 
 void mgos_epd_clear(const int colored);
 void mgos_epd_draw_absolute_pixel(const int x, const int y, const int colored);
+void mgos_epd_blit(const int x, const int y, const uint8_t *src, const int src_stride, const int src_x,
+	const int w, const int h, const uint8_t *mask, const enum mgos_epd_rop_t rop);
 
 uint8_t * mgos_epd_get_image(void);
 
@@ -57,6 +69,10 @@ void mgos_epd_set_rotate(const enum mgos_epd_rotate_t rotate);
 uint8_t* mgos_epd_getFrameBuffer(void);
 void mgos_epd_setFrameBuffer(uint8_t* image);
 
+bool mgos_epd_get_dirty(int *x, int *y, int *w, int *h);
+void mgos_epd_clear_dirty(void);
+void mgos_epd_pushDirty(const int x, const int y);
+
 void mgos_epd_draw_horizontal_line(const int x, const int y, const int line_width, const int colored);
 void mgos_epd_draw_vertical_line(const int x, const int y, const int line_height, const int colored);
 void mgos_epd_draw_rectangle(const int x0, const int y0, const int x1, const int y1, const int colored);
@@ -64,6 +80,9 @@ void mgos_epd_draw_filled_rectangle(const int x0, const int y0, const int x1, co
 void mgos_epd_drawCircle(const int x, const int y, const int radius, const int colored);
 
 
+void mgos_epd_set_text_opaque(const bool opaque);
+bool mgos_epd_get_text_opaque(void);
+void mgos_epd_glyph_cache_flush(void);
 void mgos_epd_draw_char_at(const int x, const int y, const char ascii_char, const sFONT* const font, const int colored);
 void mgos_epd_draw_string_at(const int x, const int y, const char* text, const sFONT* const font, const int colored);
 
@@ -76,7 +95,7 @@ void mgos_epdDrawPixel(const int x, const int y, const int colored);
 void mgos_epd_drawLine(const int x0, const int y0, const int x1, const int y1, const int colored);
 void mgos_epd_drawRoundRect(int16_t x0, int16_t y0, uint16_t w, uint16_t h, uint16_t r, const int colored);
 
-void mgos_epd_print(uint16_t x0, uint16_t y0, char *string);
+void mgos_epd_print(uint16_t x0, uint16_t y0, const char *string);
 
 #endif // _MGOS_LIBS_EPAPER_EPDPAINT_H
 
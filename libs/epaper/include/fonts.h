@@ -50,13 +50,40 @@ typedef struct {
 	const uint8_t *table;
 	uint16_t	Width;
 	uint16_t	Height;
+	/* Compressed fonts have no table but these, see font_rle.c */
+	const uint8_t *rle;
+	const uint16_t *rle_offsets;	/* one per glyph plus the end */
 } sFONT;
 
+/* rle_offsets flag: the glyph is stored raw, in the table layout */
+#define SFONT_RLE_RAW			0x8000
+
+/* Widest glyph row the row decoder handles, in bytes */
+#define SFONT_ROW_MAX			8
+
+/* Reads a glyph of either kind one row at a time */
+struct sfont_row_decoder {
+	const uint8_t *p, *end;
+	uint16_t width, stride;
+	uint8_t raw;
+	uint8_t nibble;
+	uint8_t color;
+	int run;
+};
+
+int sfont_glyph_begin(struct sfont_row_decoder *d, const sFONT *font, const char c);
+void sfont_glyph_row(struct sfont_row_decoder *d, uint8_t *row);
+
 extern sFONT Font24;
 extern sFONT Font20;
 extern sFONT Font16;
 extern sFONT Font12;
 extern sFONT Font8;
+
+extern sFONT Font24_RLE;
+extern sFONT Font20_RLE;
+extern sFONT Font16_RLE;
+extern sFONT Font12_RLE;
   
 #endif /* _MGOS_LIBS_EPAPER_FONTS_H */
  
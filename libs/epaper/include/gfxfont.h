@@ -10,6 +10,12 @@ typedef struct { // Data stored PER GLYPH
   int8_t   xOffset, yOffset; // Dist from cursor pos to UL corner
 } GFXglyph;
 
+struct gfxfont_range {   // Codepoints first .. first+count-1 are
+  uint32_t  first;       // glyphs glyph .. glyph+count-1
+  uint16_t  count;
+  uint16_t  glyph;
+};
+
 typedef struct { // Data stored for FONT AS A WHOLE:
   uint8_t  *bitmap;      // Glyph bitmaps, concatenated
   GFXglyph *glyph;       // Glyph array
@@ -21,8 +27,29 @@ typedef struct { // Data stored for FONT AS A WHOLE:
   int8_t    font_width;  // Maximum per-glyph width
   int8_t    font_min_xOffset;  // Left-most glyph xOffset
   int8_t    font_min_yOffset;  // Left-most glyph yOffset
+
+  struct gfxfont_file *file;   // Set for fonts loaded from the filesystem
+
+  // Fonts beyond one ASCII range: sorted, non overlapping codepoint ranges.
+  // Without them the font covers first..last.
+  const struct gfxfont_range *ranges;
+  uint16_t  range_count;
 } GFXfont;
 
+// Font files, all little endian:
+//   header   "GFXF", u8 version, u8 first, u8 last, u8 yAdvance,
+//            u16 glyph count, u16 range count, u32 bitmap bytes (16 bytes)
+//   glyphs   u32 bitmap offset, u8 width, height, xAdvance,
+//            i8 xOffset, yOffset, 3 bytes reserved             (12 bytes each)
+//   ranges   u32 first codepoint, u16 count, u16 first glyph   (8 bytes each)
+//   bitmaps  the packed glyph bitmaps, as in GFXfont->bitmap
+// Version 1 files have no ranges and cover first..last.
+#define GFXFONT_FILE_MAGIC        "GFXF"
+#define GFXFONT_FILE_VERSION      2
+#define GFXFONT_FILE_HEADER_SIZE  16
+#define GFXFONT_FILE_GLYPH_SIZE   12
+#define GFXFONT_FILE_RANGE_SIZE   8
+
 enum GFXfont_t {
   GFXFONT_NONE      = 0,
   GFXFONT_INTERNAL  = 1,
@@ -30,13 +57,42 @@ enum GFXfont_t {
 };
 
 
+struct gfxfont_run_glyph {
+  const GFXglyph *glyph;
+  int16_t   x;           // Left edge of the glyph bitmap
+};
+
+struct gfxfont_run {     // A string laid out in a font
+  const GFXfont *font;
+  uint16_t  width, height;
+  uint16_t  count;
+  struct gfxfont_run_glyph glyphs[];
+};
+
 // Internal functions -- do not use
-uint16_t ili9341_print_fillPixelLine(char *string, uint8_t line, uint8_t *buf, uint8_t color);
+GFXfont *gfxfont_file_load(const char *path);
+void gfxfont_file_free(GFXfont **font);
+const uint8_t *gfxfont_file_glyph_bitmap(const GFXfont *font, const GFXglyph *glyph);
+
+// Codepoints, strings are UTF-8:
+uint32_t gfxfont_utf8_next(const char **s);
+const GFXglyph *gfxfont_glyph_lookup(const GFXfont *f, uint32_t codepoint);
+
+// Text runs, laid out once in the current font:
+struct gfxfont_run *gfxfont_run_create(const char *string);
+struct gfxfont_run *gfxfont_run_create_n(const char *string, size_t len);
+void gfxfont_run_destroy(struct gfxfont_run **run);
+uint16_t gfxfont_run_fill_line(const struct gfxfont_run *run, uint8_t line, uint8_t *buf, uint8_t color);
+uint16_t gfxfont_run_fill_line_at(const struct gfxfont_run *run, uint8_t line, uint8_t *buf, uint16_t x0, uint16_t buf_width, uint8_t color);
+uint16_t gfxfont_text_width(const char *string, size_t len);
 
 // Fonts and Printing:
 bool mgos_ili9341_set_font(GFXfont *f);
+bool mgos_ili9341_set_font_file(const char *path);
+const GFXfont *mgos_ili9341_get_font(void);
+uint32_t mgos_ili9341_get_font_generation(void);
 void mgos_ili9341_print(uint16_t x0, uint16_t y0, char *s);
-uint16_t mgos_ili9341_getStringWidth(char *string);
-uint16_t mgos_ili9341_getStringHeight(char *string);
+uint16_t mgos_ili9341_getStringWidth(const char *string);
+uint16_t mgos_ili9341_getStringHeight(const char *string);
 
 #endif
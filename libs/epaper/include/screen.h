@@ -6,6 +6,16 @@
 #include "common/queue.h"
 #include "widget.h"
 
+// Widgets are indexed for hit tests in a grid of SCREEN_GRID_CELL pixel
+// squares; the last row and column also hold everything beyond.
+#define SCREEN_GRID_CELL  32
+#define SCREEN_GRID_DIM   8
+
+struct screen_grid_cell {
+	struct widget_t **widgets;  // that overlap the cell, topmost first
+	uint16_t num, size;
+};
+
 struct screen_t {
 	char *name;
 
@@ -13,8 +23,15 @@ struct screen_t {
 	SLIST_HEAD(widget_entries, widget_list_t) widget_entries;
 	widget_event_fn default_widget_handler;
 	void *default_user_data;
+	bool damaged;             // union of what the last screen_render() drew
+	uint16_t damage_x0, damage_y0, damage_x1, damage_y1;
+	mgos_timer_id tick_id;    // the one timer for all widget timers
+	struct screen_grid_cell grid[SCREEN_GRID_DIM][SCREEN_GRID_DIM];
 };
 
+// Widget timers due within this many msec of a screen tick fire with it
+#define SCREEN_TICK_SLACK_MSEC  20
+
 struct screen_t *screen_create(char *name);
 struct screen_t *screen_create_from_file(char *fn, widget_event_fn handler, void *user_data);
 struct screen_t *screen_create_from_json(char *json, widget_event_fn handler, void *user_data);
@@ -27,7 +44,13 @@ struct widget_t *screen_widget_add_from_file(struct screen_t *s, char *fn);
 
 bool screen_widget_destroy(struct screen_t *s, struct widget_t **w);
 
+uint16_t screen_render(struct screen_t *s);
+bool screen_get_damage(struct screen_t *s, uint16_t *x, uint16_t *y, uint16_t *w, uint16_t *h);
+
 uint16_t screen_get_num_widgets(struct screen_t *s);
 struct widget_t *screen_widget_find_by_xy(struct screen_t *s, uint16_t x, uint16_t y);
 
+// Internal functions -- do not use
+void screen_timer_update(struct screen_t *s);
+
 #endif //__SCREEN_H
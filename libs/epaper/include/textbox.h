@@ -0,0 +1,44 @@
+#ifndef __TEXTBOX_H
+#define __TEXTBOX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "gfxfont.h"
+
+// Word wrapped, aligned GFXfont text inside a box. The line breaks and
+// glyph positions are worked out once and kept until the text, the font or
+// the box changes, so redrawing an unchanged text box only rasterizes it.
+
+enum textbox_align_t {
+	TEXTBOX_ALIGN_LEFT    = 0,
+	TEXTBOX_ALIGN_CENTER  = 1,
+	TEXTBOX_ALIGN_RIGHT   = 2,
+};
+
+struct textbox_t {
+	uint16_t w, h;
+	enum textbox_align_t align;
+	bool ellipsis;            // end the last line with "..." if text is left over
+
+	// Private
+	char *text;
+	const GFXfont *font;      // the font the lines were laid out in
+	uint32_t font_generation; // and mgos_ili9341_get_font_generation() then
+	bool valid;
+	struct gfxfont_run **lines;
+	uint16_t num_lines;
+};
+
+struct textbox_t *textbox_create(uint16_t w, uint16_t h);
+void textbox_destroy(struct textbox_t **tb);
+
+bool textbox_set_text(struct textbox_t *tb, const char *text);
+void textbox_set_size(struct textbox_t *tb, uint16_t w, uint16_t h);
+void textbox_set_align(struct textbox_t *tb, enum textbox_align_t align);
+void textbox_set_ellipsis(struct textbox_t *tb, bool ellipsis);
+
+uint16_t textbox_get_num_lines(struct textbox_t *tb);
+void textbox_draw(struct textbox_t *tb, uint16_t x, uint16_t y);
+
+#endif // __TEXTBOX_H
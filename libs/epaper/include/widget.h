@@ -4,6 +4,7 @@
 #include "common/queue.h"
 
 struct widget_t;
+struct screen_t;
 
 #define EV_WIDGET_NONE       0
 #define EV_WIDGET_CREATE     1
@@ -30,13 +31,22 @@ struct widget_t {
 	char *label;
 	char *img;
 
-	uint32_t timer_msec;      // 0 to disable
+	int16_t z;                // stacking order, higher is on top; set before screen_widget_add()
+	bool opaque;              // draws every pixel of its rect, hiding what is under it
+
+	uint32_t timer_msec;      // 0 to disable, run by the screen the widget is on
 	widget_event_fn handler;  // Event callback for this widget
 	void *user_data;          // User supplied data
 
 	// Private
-	mgos_timer_id _timer_id;
+	int64_t _timer_due;       // uptime msec of the next EV_WIDGET_TIMER
+	struct screen_t *_screen; // the screen it was added to
 	uint8_t create_called;
+	uint8_t _drawn;           // has had its EV_WIDGET_DRAW
+	uint8_t _dirty;           // has damage, due for a draw at the next screen_render()
+	uint16_t _damage_x0, _damage_y0, _damage_x1, _damage_y1; // on the panel, inclusive
+	uint8_t _redo;            // drew a change last frame, the other RAM bank still lacks it
+	uint16_t _redo_x0, _redo_y0, _redo_x1, _redo_y1;
 };
 
 struct widget_list_t {
@@ -49,6 +59,8 @@ void widget_set_handler(struct widget_t *w, widget_event_fn handler, void *user_
 void widget_delete_handler(struct widget_t *w);
 void widget_set_timer(struct widget_t *w, uint32_t timer_msec);
 void widget_delete_timer(struct widget_t *w);
+void widget_invalidate(struct widget_t *w);
+void widget_invalidate_rect(struct widget_t *widget, uint16_t x, uint16_t y, uint16_t w, uint16_t h);
 struct widget_t *widget_create_from_json(const char *json);
 struct widget_t *widget_create_from_file(const char *fn);
 void widget_destroy(struct widget_t **widget);
@@ -56,5 +68,8 @@ void widget_destroy(struct widget_t **widget);
 // Convert ev in EV_WIDGET_* to string
 void widget_ev_to_str(int ev, char *s, int slen);
 
+// Internal functions -- do not use
+bool widget_timer_run(struct widget_t *w, int64_t now_msec);
+
 
 #endif // __WIDGET_H
@@ -2,6 +2,7 @@
 #include "mgos_config.h"
 #include "mgos_spi.h"
 #include "epaper.h"
+#include "epdrotate.h"
 
 static int _width=0;
 static int _height=0;
@@ -15,6 +16,80 @@ static enum epaper_update_type_t _lut = FULL_UPDATE;
 
 static struct mgos_spi *epaper_spi;
 static struct mgos_spi_txn epaper_txn;
+static int _dc_level = -1;
+
+/* Rows of a strided push are gathered into a bounce buffer of this size */
+#define EPD_PUSH_BOUNCE_SIZE	128
+
+#define EPD_MIN(a, b)			(((a) < (b)) ? (a) : (b))
+#define EPD_MAX(a, b)			(((a) > (b)) ? (a) : (b))
+
+/* Where a push lands in RAM and how much of the image it leaves out */
+struct push_window {
+	int x0, y0, x1, y1;				// RAM window, x0 and x1 + 1 on byte boundaries
+	int skip_x;						// bytes of each image row left of the window
+	int skip_y;						// image rows above the window
+};
+
+/* Synchronous pushes only write inside this, see mgos_epd_set_push_clip() */
+static struct {
+	bool active;
+	int x0, y0, x1, y1;
+} _push_clip;
+
+/* RAM bank bookkeeping, see mgos_epd_get_ram_bank() */
+static int _ram_bank = 0;
+static uint32_t _ram_epoch = 0;
+
+/* BUSY handling */
+#define EPD_BUSY_POLL_MS		2
+#define EPD_BUSY_TIMEOUT_MS		10000
+
+static mgos_epd_idle_cb_t _idle_cb = NULL;
+static void *_idle_cb_arg = NULL;
+static mgos_timer_id _idle_timer = 0;
+
+/*
+ * Shadow of the controller registers we write repeatedly.
+ * Writes that would not change anything are dropped. Everything is
+ * forgotten on reset and deep sleep.
+ */
+static struct {
+	bool window_valid;
+	uint8_t x_start, x_end;
+	uint16_t y_start, y_end;
+
+	bool pointer_valid;
+	uint8_t x_ptr;
+	uint16_t y_ptr;
+
+	int lut;						// -1 when unknown
+	int data_entry_mode;			// -1 when unknown
+
+	bool may_be_busy;				// a BUSY phase may have started since the last idle
+} _shadow = { .lut = -1, .data_entry_mode = -1, .may_be_busy = true };
+
+/* Performance counters, see mgos_epd_get_stats() */
+static struct mgos_epd_stats _stats;
+static uint64_t _busy_wait_us = 0;
+static int64_t _invalidated_at = 0;			// first mgos_epdUpdateNeeded() since the last refresh
+static int64_t _refresh_started_at = 0;		// 0 when no refresh is running
+
+/* Asynchronous push -> refresh sequence */
+enum epd_async_state_t {
+	EPD_ASYNC_IDLE			= 0,
+	EPD_ASYNC_WAIT_READY	= 1,
+	EPD_ASYNC_WAIT_REFRESH	= 2,
+};
+
+static struct {
+	enum epd_async_state_t state;
+	const uint8_t *framebuffer;
+	bool has_frame;
+	int adj_x, y, x_end, y_end;
+	mgos_epd_update_cb_t cb;
+	void *cb_arg;
+} _async;
 #if defined(USE_GLOBAL_SPI) && (USE_GLOBAL_SPI == 0)
 static struct mgos_config_spi epaper_bus_cfg;
 #endif
@@ -42,12 +117,41 @@ lut_data_t lut[2] = {
 };
 
 
+/*
+ * Command stream.
+ * Command and parameter bytes are queued here instead of being sent one
+ * byte per SPI transaction. Consecutive bytes sharing the same D/C level
+ * form a run, and every run goes out as a single transaction when the
+ * stream is flushed.
+ */
+#define EPD_CMD_STREAM_SIZE		64
+#define EPD_CMD_STREAM_RUNS		16
+
+typedef struct {
+	uint8_t dc;
+	uint8_t len;
+} cmd_run_t;
+
+static struct {
+	uint8_t buf[EPD_CMD_STREAM_SIZE];
+	cmd_run_t run[EPD_CMD_STREAM_RUNS];
+	int len;
+	int runs;
+} _cmd_stream;
+
+
 // --------------------------------------------------------------------------------------
 //
 
 static int mgos_epd_send_command(const uint8_t cmd_byte);
 static int mgos_epd_send_data(const uint8_t data_byte);
 static int mgos_epd_send_data_n(const uint8_t * const data, const int len);
+static int mgos_epd_cmd_flush(void);
+static void mgos_epd_set_dc(const int level);
+static void mgos_epd_queue_display_frame(void);
+static void mgos_epd_queue_memory_pointer(const int x, const int y);
+static void mgos_epd_shadow_invalidate(void);
+static void mgos_epd_idle_reached(void);
 
 
 static void ep_delay(const int ms)
@@ -66,29 +170,167 @@ static void ep_delay(const int ms)
  */
 int mgos_epd_reset(void)
 {
-	mgos_gpio_write(_dc_pin, 0);
+	/* push out anything still queued before the controller is reset */
+	mgos_epd_cmd_flush();
+	mgos_epd_set_dc(0);
 
 	mgos_gpio_write(_reset_pin, 0);                //module reset    
 	ep_delay(200);
 	mgos_gpio_write(_reset_pin, 1);
 	ep_delay(200);
 
+	mgos_epd_shadow_invalidate();
+	_ram_bank = 0;
+	_ram_epoch++;
+
 	return 0;
 }
 
 /**
- *  @brief: Wait until the busy_pin goes LOW
+ *  @brief: Returns true while the controller drives the busy_pin HIGH
+ */
+bool mgos_epd_is_busy(void)
+{
+	return mgos_gpio_read(_busy_pin);
+}
+
+/**
+ *  @brief: Wait until the busy_pin goes LOW, or give up after
+ *          EPD_BUSY_TIMEOUT_MS like the asynchronous wait does
+ *          this blocks the caller, see mgos_epd_wait_idle_async()
  */
 void mgos_epd_wait_idle(void)
 {
-	int busy, count=0;
+	int waited=0;
+	int64_t start;
+
+	mgos_epd_cmd_flush();
+
+	start = mgos_uptime_micros();
+	while (mgos_epd_is_busy()) {
+		ep_delay(EPD_BUSY_POLL_MS);
+		waited += EPD_BUSY_POLL_MS;
+		if (waited >= EPD_BUSY_TIMEOUT_MS) {
+			LOG(LL_ERROR, ("Still BUSY after %d ms, giving up", waited));
+			break;
+		}
+	}
+	_busy_wait_us += mgos_uptime_micros() - start;
+	mgos_epd_idle_reached();
+	LOG(LL_DEBUG, ("Busy inactive after %d ms", waited));
+}
 
-	while (0 != (busy = mgos_gpio_read(_busy_pin)))
-	{
-		ep_delay(50);
-		LOG(LL_ERROR, ("Still BUSY .. %d", ++count));
+
+/**
+ *  @brief: The controller was seen idle, account for a finished refresh
+ */
+static void mgos_epd_idle_reached(void)
+{
+	int64_t now = mgos_uptime_micros();
+	uint32_t ms;
+
+	_shadow.may_be_busy = false;
+
+	if (_refresh_started_at == 0) {
+		return;
+	}
+
+	ms = (now - (_invalidated_at ? _invalidated_at : _refresh_started_at)) / 1000;
+	_stats.last_refresh_ms = ms;
+	_stats.total_refresh_ms += ms;
+	if (ms > _stats.max_refresh_ms) {
+		_stats.max_refresh_ms = ms;
 	}
-	// LOG(LL_INFO, ("Busy inactive"));
+	_refresh_started_at = 0;
+	_invalidated_at = 0;
+}
+
+
+/**
+ *  @brief: Complete a pending asynchronous wait and call its callback
+ */
+static void mgos_epd_idle_done(void *arg)
+{
+	mgos_epd_idle_cb_t cb = _idle_cb;
+	void *cb_arg = _idle_cb_arg;
+
+	if (cb == NULL) {
+		return;
+	}
+
+	mgos_epd_idle_reached();
+	mgos_gpio_disable_int(_busy_pin);
+	if (_idle_timer) {
+		mgos_clear_timer(_idle_timer);
+		_idle_timer = 0;
+	}
+	_idle_cb = NULL;
+	_idle_cb_arg = NULL;
+
+	cb(cb_arg);
+	(void) arg;
+}
+
+/**
+ *  @brief: Complete the pending wait only if the line is actually LOW
+ */
+static void mgos_epd_idle_check(void *arg)
+{
+	if (!mgos_epd_is_busy()) {
+		mgos_epd_idle_done(arg);
+	}
+}
+
+/**
+ *  @brief: BUSY falling edge, runs on the Mongoose task
+ */
+static void mgos_epd_busy_int_cb(const int pin, void *arg)
+{
+	mgos_epd_idle_check(arg);
+	(void) pin;
+}
+
+/**
+ *  @brief: Safety net in case the falling edge was lost
+ */
+static void mgos_epd_busy_timeout_cb(void *arg)
+{
+	_idle_timer = 0;
+	if (mgos_epd_is_busy()) {
+		LOG(LL_ERROR, ("Still BUSY after %d ms, giving up", EPD_BUSY_TIMEOUT_MS));
+	}
+	mgos_epd_idle_done(NULL);
+	(void) arg;
+}
+
+/**
+ *  @brief: Call cb once the busy_pin goes LOW, without blocking the event loop.
+ *          The callback always runs from the Mongoose task, never from
+ *          within this call. Only one wait can be pending at a time.
+ */
+bool mgos_epd_wait_idle_async(mgos_epd_idle_cb_t cb, void *arg)
+{
+	if (cb == NULL) {
+		return false;
+	}
+	if (_idle_cb != NULL) {
+		LOG(LL_ERROR, ("An asynchronous BUSY wait is already pending"));
+		return false;
+	}
+
+	mgos_epd_cmd_flush();
+
+	_idle_cb = cb;
+	_idle_cb_arg = arg;
+	_idle_timer = mgos_set_timer(EPD_BUSY_TIMEOUT_MS, 0, mgos_epd_busy_timeout_cb, NULL);
+	mgos_gpio_enable_int(_busy_pin);
+
+	/* the edge may have come and gone before the interrupt was enabled */
+	if (!mgos_epd_is_busy()) {
+		mgos_invoke_cb(mgos_epd_idle_check, NULL, false /* from_isr */);
+	}
+
+	return true;
 }
 
 
@@ -97,80 +339,302 @@ void mgos_epd_sleep(void)
 {
 	mgos_epd_send_command(DEEP_SLEEP_MODE);
 	mgos_epd_wait_idle();
+	/* only a hardware reset wakes the controller up again */
+	mgos_epd_shadow_invalidate();
+}
+
+
+/**
+ *  @brief: Clip an image to the panel, and if clip is set to the push clip
+ *          rectangle too, and work out its RAM window.
+ *          Returns false if there is nothing to push.
+ */
+static bool mgos_epd_push_window(const int start_x, const int start_y, const int image_width, const int image_height,
+	const bool clip, struct push_window *pw)
+{
+	/* x point must be the multiple of 8 or the last 3 bits will be ignored */
+	int adj_image_width = image_width & ~0x07;
+	int adj_x = start_x & ~0x07;
+	int cx0 = 0, cy0 = 0, cx1 = _width - 1, cy1 = _height - 1;
+
+	if ((adj_image_width <= 0) || (image_height <= 0)) {
+		return false;
+	}
+	if (clip && _push_clip.active) {
+		cx0 = EPD_MAX(cx0, _push_clip.x0);
+		cy0 = EPD_MAX(cy0, _push_clip.y0);
+		cx1 = EPD_MIN(cx1, _push_clip.x1);
+		cy1 = EPD_MIN(cy1, _push_clip.y1);
+	}
+
+	pw->x0 = EPD_MAX(adj_x, cx0);
+	pw->y0 = EPD_MAX(start_y, cy0);
+	pw->x1 = EPD_MIN(adj_x + adj_image_width - 1, cx1);
+	pw->y1 = EPD_MIN(start_y + image_height - 1, cy1);
+	pw->skip_x = (pw->x0 - adj_x) / 8;
+	pw->skip_y = pw->y0 - start_y;
+
+	return (pw->x0 <= pw->x1) && (pw->y0 <= pw->y1);
+}
+
+/**
+ *  @brief: Only let synchronous pushes write inside the given rectangle
+ *          of the frame memory, e.g. to keep a widget inside its bounds.
+ *          x is widened to whole bytes. The asynchronous update isn't
+ *          clipped.
+ */
+void mgos_epd_set_push_clip(const int x, const int y, const int width, const int height)
+{
+	_push_clip.active = true;
+	_push_clip.x0 = x & ~0x07;
+	_push_clip.y0 = y;
+	_push_clip.x1 = (x + width - 1) | 0x07;
+	_push_clip.y1 = y + height - 1;
+}
+
+void mgos_epd_clear_push_clip(void)
+{
+	_push_clip.active = false;
+}
+
+/**
+ *  @brief: The push clip in panel pixels, false if pushes aren't clipped
+ */
+bool mgos_epd_get_push_clip(int *x, int *y, int *width, int *height)
+{
+	if (!_push_clip.active) {
+		return false;
+	}
+	*x = _push_clip.x0;
+	*y = _push_clip.y0;
+	*width = _push_clip.x1 - _push_clip.x0 + 1;
+	*height = _push_clip.y1 - _push_clip.y0 + 1;
+	return true;
+}
+
+
+/**
+ *  @brief: Send WRITE_RAM and the image data for an already set up window
+ */
+static void mgos_epd_write_frame(const uint8_t* framebuffer, const int adj_x, const int start_y, const int x_end, const int y_end)
+{
+	int bufferlen;
+
+	mgos_epd_send_command(WRITE_RAM);
+	/* the address counter moves along with the data */
+	_shadow.pointer_valid = false;
+
+	/* send the image data, the queued commands go out first */
+	bufferlen = (y_end - start_y + 1) * ((x_end - adj_x + 1) / 8);
+	mgos_epd_send_data_n(framebuffer , bufferlen);
 }
 
 
 /**
  *  @brief: Push an image buffer to the frame memory.
+ *          An image hanging over the right edge of the panel is cut
+ *          row by row, so its rows stay aligned.
  *          this won't update the display.
  *
  */
 void mgos_epd_pushFrameBuffer(const uint8_t* framebuffer, const int start_x, const int start_y, const int image_width, const int image_height)
 {
-	int x_end, y_end;
+	mgos_epd_pushFrameBufferStride(framebuffer, (image_width & ~0x07) / 8, start_x, start_y, image_width, image_height);
+}
 
-	/* x point must be the multiple of 8 or the last 3 bits will be ignored */
-	int adj_image_width = image_width & 0xF8;
-	int adj_x = start_x & 0xF8;
-	int bufferlen;
 
-	if ( (framebuffer == NULL) || (adj_x < 0) || (image_width < 0) || (start_y < 0) || (image_height < 0) ) {
+/**
+ *  @brief: Push a rectangle out of a larger image buffer to the frame memory.
+ *          framebuffer points at the first byte of the rectangle and rows
+ *          are stride bytes apart. Rows are gathered into a bounce buffer
+ *          so the data still goes out in a few large transactions.
+ *          this won't update the display.
+ */
+void mgos_epd_pushFrameBufferStride(const uint8_t* framebuffer, const int stride, const int start_x, const int start_y, const int image_width, const int image_height)
+{
+	uint8_t bounce[EPD_PUSH_BOUNCE_SIZE];
+	struct push_window pw;
+	int row_bytes, rows, row, fill=0;
+
+	if (!framebuffer || !mgos_epd_push_window(start_x, start_y, image_width, image_height, true, &pw)) {
 		return;
 	}
 
-	if (adj_x + adj_image_width >= _width) {
-		x_end = _width - 1;
-	} else {
-		x_end = adj_x + adj_image_width - 1;
-	}
+	framebuffer += pw.skip_y * stride + pw.skip_x;
+	row_bytes = (pw.x1 - pw.x0 + 1) / 8;
+	rows = pw.y1 - pw.y0 + 1;
 
-	if (start_y + image_height >= _height) {
-		y_end = _height - 1;
-	} else {
-		y_end = start_y + image_height - 1;
-	}
+	mgos_epd_set_memory_area(pw.x0, pw.y0, pw.x1, pw.y1);
+	mgos_epd_set_memory_pointer(pw.x0, pw.y0);
 
-	mgos_epd_set_memory_area(adj_x, start_y, x_end, y_end);
-	mgos_epd_set_memory_pointer(adj_x, start_y);
+	if (stride == row_bytes) {
+		mgos_epd_write_frame(framebuffer, pw.x0, pw.y0, pw.x1, pw.y1);
+		return;
+	}
 
 	mgos_epd_send_command(WRITE_RAM);
+	/* the address counter moves along with the data */
+	_shadow.pointer_valid = false;
 
-	/* send the image data */
-	bufferlen = (y_end - start_y + 1) * ((x_end - adj_x + 1) / 8);
-	mgos_epd_send_data_n(framebuffer , bufferlen);
+	for (row=0; row < rows; row++) {
+		const uint8_t *src = framebuffer + row * stride;
+
+		if (row_bytes > EPD_PUSH_BOUNCE_SIZE) {
+			mgos_epd_send_data_n(src, row_bytes);
+			continue;
+		}
+		if (fill + row_bytes > EPD_PUSH_BOUNCE_SIZE) {
+			mgos_epd_send_data_n(bounce, fill);
+			fill = 0;
+		}
+		memcpy(&bounce[fill], src, row_bytes);
+		fill += row_bytes;
+	}
+	if (fill) {
+		mgos_epd_send_data_n(bounce, fill);
+	}
 }
 
 
-void mgos_epd_pushFrameBufferRel(const uint8_t* framebuffer, const int start_x, const int start_y, const int image_width, const int image_height)
+/**
+ *  @brief: push an image whose rows are made on the fly. cb is called for
+ *          row 0, 1, ... and fills image_width / 8 bytes of buf; all rows
+ *          go into one RAM window, gathered in the bounce buffer.
+ *          this won't update the display.
+ */
+void mgos_epd_pushFrameBufferRows(const int start_x, const int start_y, const int image_width, const int image_height, mgos_epd_row_cb_t cb, void *arg)
 {
-	int x_end, y_end;
+	uint8_t bounce[EPD_PUSH_BOUNCE_SIZE];
+	uint8_t *rowbuf = NULL;
+	struct push_window pw;
+	int stride, row_bytes, rows, row, fill=0;
 
-	/* x point must be the multiple of 8 or the last 3 bits will be ignored */
-	int adj_image_width = image_width & 0xF8;
-	int adj_x = start_x & 0xF8;
-	int bufferlen;
+	if (!cb || !mgos_epd_push_window(start_x, start_y, image_width, image_height, true, &pw)) {
+		return;
+	}
 
-	if ( (framebuffer == NULL) || (adj_x < 0) || (image_width < 0) || (start_y < 0) || (image_height < 0) ) {
+	stride = (image_width & ~0x07) / 8;
+	row_bytes = (pw.x1 - pw.x0 + 1) / 8;
+	rows = pw.y1 - pw.y0 + 1;
+
+	if (stride > EPD_PUSH_BOUNCE_SIZE) {
+		rowbuf = malloc(stride);
+		if (!rowbuf) {
+			LOG(LL_ERROR, ("could not malloc %d bytes for a row", stride));
+			return;
+		}
+	}
+
+	mgos_epd_set_memory_area(pw.x0, pw.y0, pw.x1, pw.y1);
+	mgos_epd_set_memory_pointer(pw.x0, pw.y0);
+	mgos_epd_send_command(WRITE_RAM);
+	/* the address counter moves along with the data */
+	_shadow.pointer_valid = false;
+
+	for (row=0; row < rows; row++) {
+		if (rowbuf) {
+			cb(pw.skip_y + row, rowbuf, arg);
+			mgos_epd_send_data_n(&rowbuf[pw.skip_x], row_bytes);
+			continue;
+		}
+		if (fill + stride > EPD_PUSH_BOUNCE_SIZE) {
+			mgos_epd_send_data_n(bounce, fill);
+			fill = 0;
+		}
+		/* a clipped row's tail is overwritten by the next one */
+		cb(pw.skip_y + row, &bounce[fill], arg);
+		if (pw.skip_x) {
+			memmove(&bounce[fill], &bounce[fill + pw.skip_x], row_bytes);
+		}
+		fill += row_bytes;
+	}
+	if (fill) {
+		mgos_epd_send_data_n(bounce, fill);
+	}
+	free(rowbuf);
+}
+
+/**
+ *  @brief: push a frame drawn unrotated, rotating it on the way out.
+ *          The panel gets what drawing the same picture on a buffer set
+ *          to mgos_epd_set_rotate(rotate) would have given, but the
+ *          drawing itself skips the per pixel rotation. width must be a
+ *          multiple of 8, and for ROTATE_90 / ROTATE_270 so must height.
+ *          (x, y) is where the rotated frame's top left corner goes.
+ *          this won't update the display.
+ */
+void mgos_epd_pushFrameBufferRotated(const uint8_t* framebuffer, const int width, const int height,
+	const enum mgos_epd_rotate_t rotate, const int start_x, const int start_y)
+{
+	int out_width, out_height, out_stride;
+	struct push_window pw;
+	int row_bytes, band, n, r;
+	uint8_t *out;
+
+	if ((width & 0x07) || (((rotate == ROTATE_90) || (rotate == ROTATE_270)) && (height & 0x07))) {
+		LOG(LL_ERROR, ("frame of %dx%d can't be rotated, sizes must be multiples of 8", width, height));
+		return;
+	}
+	if (rotate == ROTATE_0) {
+		mgos_epd_pushFrameBuffer(framebuffer, start_x, start_y, width, height);
 		return;
 	}
 
-	if (adj_x + adj_image_width >= _width) {
-		x_end = _width - 1;
-	} else {
-		x_end = adj_x + adj_image_width - 1;
+	epd_rotate_size(width, height, rotate, &out_width, &out_height);
+	if (!framebuffer || !mgos_epd_push_window(start_x, start_y, out_width, out_height, true, &pw)) {
+		return;
 	}
+	out_stride = out_width / 8;
+	row_bytes = (pw.x1 - pw.x0 + 1) / 8;
 
-	if (start_y + image_height >= _height) {
-		y_end = _height - 1;
-	} else {
-		y_end = start_y + image_height - 1;
+	/* one band of 8 rotated rows at a time */
+	out = malloc(8 * out_stride);
+	if (!out) {
+		LOG(LL_ERROR, ("could not malloc %d bytes for rotation", 8 * out_stride));
+		return;
 	}
 
+	mgos_epd_set_memory_area(pw.x0, pw.y0, pw.x1, pw.y1);
+	mgos_epd_set_memory_pointer(pw.x0, pw.y0);
 	mgos_epd_send_command(WRITE_RAM);
+	/* the address counter moves along with the data */
+	_shadow.pointer_valid = false;
 
-	/* send the image data */
-	bufferlen = (y_end - start_y + 1) * ((x_end - adj_x + 1) / 8);
-	mgos_epd_send_data_n(framebuffer , bufferlen);
+	/* bands of rotated rows, the ones the window cuts off are skipped */
+	for (band = pw.skip_y / 8; band * 8 <= pw.skip_y + (pw.y1 - pw.y0); band++) {
+		const int first = EPD_MAX(pw.skip_y - band * 8, 0);
+
+		n = epd_rotate_band(framebuffer, width, height, rotate, band, out);
+		if (n > pw.skip_y + (pw.y1 - pw.y0) + 1 - band * 8) {
+			n = pw.skip_y + (pw.y1 - pw.y0) + 1 - band * 8;
+		}
+		if ((row_bytes == out_stride) && (first == 0)) {
+			mgos_epd_send_data_n(out, n * out_stride);
+			continue;
+		}
+		for (r = first; r < n; r++) {
+			mgos_epd_send_data_n(&out[r * out_stride + pw.skip_x], row_bytes);
+		}
+	}
+	free(out);
+}
+
+
+/**
+ *  @brief: Push an image buffer at the current RAM window and address
+ *          counter, which the caller has set up.
+ *          this won't update the display.
+ */
+void mgos_epd_pushFrameBufferRel(const uint8_t* framebuffer, const int start_x, const int start_y, const int image_width, const int image_height)
+{
+	struct push_window pw;
+
+	/* the data goes where the address counter is, it can only be cut at the right and bottom */
+	if (!framebuffer || !mgos_epd_push_window(start_x, start_y, image_width, image_height, false, &pw) || pw.skip_x || pw.skip_y) {
+		return;
+	}
+
+	mgos_epd_write_frame(framebuffer, pw.x0, pw.y0, pw.x1, pw.y1);
 }
 
 
@@ -186,6 +650,8 @@ void mgos_epd_clear_frame_memory(const uint8_t color)
 	mgos_epd_set_memory_pointer(0, 0);
 
 	mgos_epd_send_command(WRITE_RAM);
+	/* the address counter moves along with the data */
+	_shadow.pointer_valid = false;
 	// send the color data
 	#if 0
 	for (i=0; i < ((_width / 8) * _height); i++) {
@@ -199,9 +665,34 @@ void mgos_epd_clear_frame_memory(const uint8_t color)
 	}
 	free(tmp_buffer);
 	#endif
+	/* whatever was pushed to this bank before is gone */
+	_ram_epoch++;
 	mgos_epd_wait_idle();
 }
 
+/**
+ *  @brief: queue the display update sequence, without waiting for it
+ */
+static void mgos_epd_queue_display_frame(void)
+{
+	mgos_epd_send_command(DISPLAY_UPDATE_CONTROL_2);
+	mgos_epd_send_data(0xC4);
+	mgos_epd_send_command(MASTER_ACTIVATION);
+	mgos_epd_send_command(TERMINATE_FRAME_READ_WRITE);
+	mgos_epd_cmd_flush();
+
+	_shadow.pointer_valid = false;
+	_shadow.may_be_busy = true;
+	_ram_bank ^= 1;
+
+	if (_lut == PARTIAL_UPDATE) {
+		_stats.partial_refreshes++;
+	} else {
+		_stats.full_refreshes++;
+	}
+	_refresh_started_at = mgos_uptime_micros();
+}
+
 /**
  *  @brief: update the display
  *          there are 2 memory areas embedded in the e-paper display
@@ -211,44 +702,89 @@ void mgos_epd_clear_frame_memory(const uint8_t color)
  */
 void mgos_epd_display_frame(void)
 {
-	mgos_epd_send_command(DISPLAY_UPDATE_CONTROL_2);
-	mgos_epd_send_data(0xC4);
-	mgos_epd_send_command(MASTER_ACTIVATION);
-	mgos_epd_send_command(TERMINATE_FRAME_READ_WRITE);
-
+	mgos_epd_queue_display_frame();
 	mgos_epd_wait_idle();
 }
 
 
 /**
  *  @brief: private function to specify the memory area for data R/W
+ *          the bytes are only queued, they go out with the next flush
  */
 void mgos_epd_set_memory_area(const int x_start, const int y_start, const int x_end, const int y_end)
 {
-	mgos_epd_send_command(SET_RAM_X_ADDRESS_START_END_POSITION);
 	/* x point must be the multiple of 8 or the last 3 bits will be ignored */
-	mgos_epd_send_data((x_start >> 3) & 0xFF);
-	mgos_epd_send_data((x_end >> 3) & 0xFF);
+	const uint8_t xs = (x_start >> 3) & 0xFF;
+	const uint8_t xe = (x_end >> 3) & 0xFF;
+
+	if (_shadow.window_valid &&
+		(_shadow.x_start == xs) && (_shadow.x_end == xe) &&
+		(_shadow.y_start == y_start) && (_shadow.y_end == y_end)) {
+		return;
+	}
+
+	mgos_epd_send_command(SET_RAM_X_ADDRESS_START_END_POSITION);
+	mgos_epd_send_data(xs);
+	mgos_epd_send_data(xe);
 	mgos_epd_send_command(SET_RAM_Y_ADDRESS_START_END_POSITION);
 	mgos_epd_send_data(y_start & 0xFF);
 	mgos_epd_send_data((y_start >> 8) & 0xFF);
 	mgos_epd_send_data(y_end & 0xFF);
 	mgos_epd_send_data((y_end >> 8) & 0xFF);
+
+	_shadow.window_valid = true;
+	_shadow.x_start = xs;
+	_shadow.x_end = xe;
+	_shadow.y_start = y_start;
+	_shadow.y_end = y_end;
 }
 
 /**
- *  @brief: private function to specify the start point for data R/W
+ *  @brief: queue the start point for data R/W, without waiting for idle
  */
-void mgos_epd_set_memory_pointer(const int x, const int y)
+static void mgos_epd_queue_memory_pointer(const int x, const int y)
 {
-	mgos_epd_send_command(SET_RAM_X_ADDRESS_COUNTER);
 	/* x point must be the multiple of 8 or the last 3 bits will be ignored */
-	mgos_epd_send_data((x >> 3) & 0xFF);
+	const uint8_t xp = (x >> 3) & 0xFF;
+
+	if (_shadow.pointer_valid && (_shadow.x_ptr == xp) && (_shadow.y_ptr == y)) {
+		return;
+	}
+
+	mgos_epd_send_command(SET_RAM_X_ADDRESS_COUNTER);
+	mgos_epd_send_data(xp);
 	mgos_epd_send_command(SET_RAM_Y_ADDRESS_COUNTER);
 	mgos_epd_send_data(y & 0xFF);
 	mgos_epd_send_data((y >> 8) & 0xFF);
 
-	mgos_epd_wait_idle();
+	_shadow.pointer_valid = true;
+	_shadow.x_ptr = xp;
+	_shadow.y_ptr = y;
+}
+
+/**
+ *  @brief: private function to specify the start point for data R/W
+ *          waits for the controller only if a refresh may still be running
+ */
+void mgos_epd_set_memory_pointer(const int x, const int y)
+{
+	mgos_epd_queue_memory_pointer(x, y);
+	if (_shadow.may_be_busy) {
+		mgos_epd_wait_idle();
+	}
+}
+
+
+/**
+ *  @brief: forget everything we know about the controller registers
+ */
+static void mgos_epd_shadow_invalidate(void)
+{
+	_shadow.window_valid = false;
+	_shadow.pointer_valid = false;
+	_shadow.lut = -1;
+	_shadow.data_entry_mode = -1;
+	_shadow.may_be_busy = true;
 }
 
 
@@ -266,6 +802,11 @@ void mgos_epd_set_lut(enum epaper_update_type_t lut_type)
 		return;
 	}
 
+	if (_shadow.lut == (int)lut_type) {
+		return;
+	}
+	_shadow.lut = lut_type;
+
 	p=(uint8_t *)&lut[lut_type];
 
 	mgos_epd_send_command(WRITE_LUT_REGISTER);
@@ -301,10 +842,14 @@ bool mgos_epd_display_init(enum epaper_update_type_t type)
 	mgos_epd_send_data(0x1A);                     // 4 dummy lines per gate
 	mgos_epd_send_command(SET_GATE_TIME);
 	mgos_epd_send_data(0x08);                     // 2us per line
-	mgos_epd_send_command(DATA_ENTRY_MODE_SETTING);
-	mgos_epd_send_data(0x03);                     // X increment; Y increment
+	if (_shadow.data_entry_mode != 0x03) {
+		mgos_epd_send_command(DATA_ENTRY_MODE_SETTING);
+		mgos_epd_send_data(0x03);                     // X increment; Y increment
+		_shadow.data_entry_mode = 0x03;
+	}
 
 	mgos_epd_set_lut( type );
+	mgos_epd_cmd_flush();
 
 	return 0;
 }
@@ -315,8 +860,9 @@ bool mgos_epd_display_init(enum epaper_update_type_t type)
  */
 static int mgos_epd_write_spi(const uint8_t * const data, const int len)
 {
-	/* Half-duplex, command/response transaction setup */
-	/* Transmit 1 byte from tx_data. */
+	_stats.spi_txns++;
+	_stats.spi_bytes += len;
+
 	epaper_txn.fd.len = len;
 	epaper_txn.fd.tx_data = data;
 	epaper_txn.fd.rx_data = NULL;
@@ -331,51 +877,251 @@ static int mgos_epd_write_spi(const uint8_t * const data, const int len)
 
 
 /**
- *  @brief: A primitive to send a commend to ePaper
+ *  @brief: Drive the D/C line, skipping the GPIO write if it already has the level
  */
-static int mgos_epd_send_command(const uint8_t cmd_byte)
+static void mgos_epd_set_dc(const int level)
+{
+	if (level != _dc_level) {
+		mgos_gpio_write(_dc_pin, level);
+		if (_dc_level != -1) {
+			_stats.dc_toggles++;
+		}
+		_dc_level = level;
+	}
+}
+
+
+/**
+ *  @brief: Send all queued command stream runs, one SPI transaction per run
+ */
+static int mgos_epd_cmd_flush(void)
+{
+	int i, pos=0, ret=0;
+
+	for (i=0; i < _cmd_stream.runs; i++) {
+		mgos_epd_set_dc(_cmd_stream.run[i].dc);
+		if (0 != mgos_epd_write_spi(&_cmd_stream.buf[pos], _cmd_stream.run[i].len)) {
+			ret = -1;
+		}
+		pos += _cmd_stream.run[i].len;
+	}
+	_cmd_stream.len = 0;
+	_cmd_stream.runs = 0;
+
+	return ret;
+}
+
+
+/**
+ *  @brief: Queue one byte to the command stream with the given D/C level
+ */
+static int mgos_epd_cmd_queue(const int dc, const uint8_t byte)
 {
-	const uint8_t data = cmd_byte;
+	cmd_run_t *run = (_cmd_stream.runs > 0) ? &_cmd_stream.run[_cmd_stream.runs - 1] : NULL;
+	int ret = 0;
+
+	if ((_cmd_stream.len >= EPD_CMD_STREAM_SIZE) ||
+		((_cmd_stream.runs >= EPD_CMD_STREAM_RUNS) && (run->dc != dc))) {
+		ret = mgos_epd_cmd_flush();
+		run = NULL;
+	}
+
+	if ((run == NULL) || (run->dc != dc)) {
+		run = &_cmd_stream.run[_cmd_stream.runs++];
+		run->dc = dc;
+		run->len = 0;
+	}
+	_cmd_stream.buf[_cmd_stream.len++] = byte;
+	run->len++;
+
+	return ret;
+}
 
-	mgos_gpio_write( _dc_pin, 0);
 
-	return mgos_epd_write_spi(&data, 1);
+/**
+ *  @brief: A primitive to queue a command to ePaper
+ */
+static int mgos_epd_send_command(const uint8_t cmd_byte)
+{
+	return mgos_epd_cmd_queue(0, cmd_byte);
 }
 
 /**
- *  @brief: A primitive to send a single byte of data to ePaper
+ *  @brief: A primitive to queue a single byte of data to ePaper
  */
 static int mgos_epd_send_data(const uint8_t data_byte)
 {
-	const uint8_t data = data_byte;
+	return mgos_epd_cmd_queue(1, data_byte);
+}
 
-	mgos_gpio_write( _dc_pin, 1);
+/**
+ *  @brief: A primitive function to push a data block to ePaper.
+ *          Queued commands are flushed first, the block itself is sent
+ *          straight from the caller's buffer in one transaction.
+ */
+static int mgos_epd_send_data_n(const uint8_t * const data, const int len)
+{
+	int ret;
+
+	ret = mgos_epd_cmd_flush();
+	if (len <= 0) {
+		return ret;
+	}
 
-	return mgos_epd_write_spi(&data, 1);
+	mgos_epd_set_dc(1);
+	if (0 != mgos_epd_write_spi(data, len)) {
+		ret = -1;
+	}
+
+	return ret;
 }
 
 /**
- *  @brief: A primitive function to push data to Mongoose-SPI
+ *  @brief: One step of the asynchronous push -> refresh sequence.
+ *          Every step is entered from a BUSY idle callback. SPI transactions
+ *          complete synchronously on Mongoose, so the frame data goes out
+ *          within the step that starts it.
  */
-static int mgos_epd_send_data_n(const uint8_t * const data, const int len)
+static void mgos_epd_async_step(void *arg)
 {
-	mgos_gpio_write( _dc_pin, 1);
+	mgos_epd_update_cb_t cb;
+	void *cb_arg;
+
+	switch (_async.state) {
+	case EPD_ASYNC_WAIT_READY:
+		if (_async.has_frame) {
+			mgos_epd_set_memory_area(_async.adj_x, _async.y, _async.x_end, _async.y_end);
+			mgos_epd_queue_memory_pointer(_async.adj_x, _async.y);
+			mgos_epd_write_frame(_async.framebuffer, _async.adj_x, _async.y, _async.x_end, _async.y_end);
+		}
+		mgos_epd_queue_display_frame();
+		_async.state = EPD_ASYNC_WAIT_REFRESH;
+		if (!mgos_epd_wait_idle_async(mgos_epd_async_step, NULL)) {
+			/* should not happen, the sequence owns the BUSY wait; fall back */
+			mgos_epd_wait_idle();
+			mgos_epd_async_step(NULL);
+		}
+		break;
+
+	case EPD_ASYNC_WAIT_REFRESH:
+		cb = _async.cb;
+		cb_arg = _async.cb_arg;
+		_async.state = EPD_ASYNC_IDLE;
+		_async.framebuffer = NULL;
+		if (cb) {
+			cb(cb_arg);
+		}
+		break;
 
-	epaper_txn.fd.len = len;
-	epaper_txn.fd.tx_data = data;
-	epaper_txn.fd.rx_data = NULL;
+	case EPD_ASYNC_IDLE:
+	default:
+		break;
+	}
+	(void) arg;
+}
 
-	if (!mgos_spi_run_txn(epaper_spi, true /* full_duplex */, &epaper_txn)) {
-		LOG(LL_ERROR, ("SPI transaction failed"));
-		return -1;
+
+/**
+ *  @brief: Push an image buffer and refresh the display without blocking.
+ *          framebuffer may be NULL to only refresh. The buffer must stay
+ *          valid until cb is called, which happens once the new image is
+ *          on the panel. Returns false if an update is already in flight.
+ */
+bool mgos_epd_update_async(const uint8_t* framebuffer, const int start_x, const int start_y, const int image_width, const int image_height, mgos_epd_update_cb_t cb, void *arg)
+{
+	if (_async.state != EPD_ASYNC_IDLE) {
+		LOG(LL_ERROR, ("An asynchronous update is already in progress"));
+		return false;
 	}
 
-	return 0;
+	_async.has_frame = false;
+	if (framebuffer != NULL) {
+		struct push_window pw;
+
+		/* the frame goes out whole, it can only be cut at the right and bottom */
+		if (!mgos_epd_push_window(start_x, start_y, image_width, image_height, false, &pw) || pw.skip_x || pw.skip_y) {
+			return false;
+		}
+		_async.adj_x = pw.x0;
+		_async.x_end = pw.x1;
+		_async.y_end = pw.y1;
+		_async.has_frame = true;
+	}
+	_async.framebuffer = framebuffer;
+	_async.y = start_y;
+	_async.cb = cb;
+	_async.cb_arg = arg;
+	_async.state = EPD_ASYNC_WAIT_READY;
+
+	if (!mgos_epd_wait_idle_async(mgos_epd_async_step, NULL)) {
+		_async.state = EPD_ASYNC_IDLE;
+		return false;
+	}
+
+	return true;
 }
 
+/**
+ *  @brief: Refresh the display from frame memory without blocking
+ */
+bool mgos_epd_display_frame_async(mgos_epd_update_cb_t cb, void *arg)
+{
+	return mgos_epd_update_async(NULL, 0, 0, 0, 0, cb, arg);
+}
+
+bool mgos_epd_async_in_progress(void)
+{
+	return (_async.state != EPD_ASYNC_IDLE);
+}
+
+
 void mgos_epdUpdateNeeded(void)
 {
 	_isdirty = true;
+	if (_invalidated_at == 0) {
+		_invalidated_at = mgos_uptime_micros();
+	}
+}
+
+
+/**
+ *  @brief: The controller RAM bank the next push goes to, 0 or 1.
+ *          The banks swap on every display refresh, so a bank only holds
+ *          what was pushed since the refresh before last.
+ */
+int mgos_epd_get_ram_bank(void)
+{
+	return _ram_bank;
+}
+
+/**
+ *  @brief: Changes whenever the RAM content can no longer be trusted,
+ *          i.e. after a reset or a clear of the frame memory.
+ */
+uint32_t mgos_epd_get_ram_epoch(void)
+{
+	return _ram_epoch;
+}
+
+
+/**
+ *  @brief: Driver performance counters since boot or the last clear
+ */
+const struct mgos_epd_stats *mgos_epd_get_stats(void)
+{
+	_stats.busy_wait_ms = _busy_wait_us / 1000;
+	return &_stats;
+}
+
+void mgos_epd_clear_stats(void)
+{
+	memset(&_stats, 0, sizeof(_stats));
+	_busy_wait_us = 0;
+}
+
+bool mgos_epdIsUpdateNeeded(void)
+{
+	return _isdirty;
 }
 
 void mgos_epdUpdate(void)
@@ -412,6 +1158,7 @@ bool mgos_epaper_init(void)
 
 	_dc_pin = mgos_sys_config_get_epaper_dc_pin();
 	mgos_gpio_write(_dc_pin, 1);
+	_dc_level = 1;
 	mgos_gpio_set_mode(_dc_pin, MGOS_GPIO_MODE_OUTPUT);
 
 	_cs_pin = mgos_sys_config_get_epaper_cs_pin();
@@ -426,6 +1173,7 @@ bool mgos_epaper_init(void)
 	_busy_pin = mgos_sys_config_get_epaper_busy_pin();
 	mgos_gpio_set_pull(_busy_pin, MGOS_GPIO_PULL_UP);
 	mgos_gpio_set_mode(_busy_pin, MGOS_GPIO_MODE_INPUT);
+	mgos_gpio_set_int_handler(_busy_pin, MGOS_GPIO_INT_EDGE_NEG, mgos_epd_busy_int_cb, NULL);
 
 	LOG(LL_INFO, ("cs=%d d/c=%d busy=%d reset=%d", _cs_pin, _dc_pin, _busy_pin, _reset_pin));
 
@@ -452,5 +1200,7 @@ bool mgos_epaper_init(void)
 		LOG(LL_ERROR, ("Could not initialize ePaper display"));
 	}
 
+	mgos_epd_rpc_init();
+
 	return true;
 }
@@ -0,0 +1,267 @@
+#include "mgos.h"
+#include "mgos_config.h"
+#include "epaper.h"
+
+/*
+ * Frame diff encoder.
+ * Keeps a copy of what was last pushed to each controller RAM bank, XORs
+ * the new frame against it and pushes only a few byte aligned rectangles
+ * that cover the changes. Rectangles are merged whenever sending the extra
+ * unchanged bytes is cheaper than setting up another RAM window.
+ *
+ * The copies are only right if every write to the frame memory goes
+ * through mgos_epd_push_diff(); a reset or a frame memory clear makes
+ * the next push a full one.
+ */
+
+/* Cost of an extra RAM window, in data byte equivalents (13 command and
+ * parameter bytes, plus per transaction overhead for 8 transactions) */
+#define EPD_DIFF_WINDOW_COST	24
+
+/* Changed bytes on a row further apart than this start a new segment */
+#define EPD_DIFF_SEGMENT_GAP	4
+
+#define EPD_DIFF_MAX_RECTS		16
+
+struct diff_rect {
+	int x0, x1;				// byte columns, inclusive
+	int y0, y1;				// rows, inclusive
+};
+
+static uint8_t *_shadow[2] = { NULL, NULL };
+static bool _shadow_valid[2] = { false, false };
+static uint32_t _shadow_epoch[2];
+static int _stride = 0;
+static int _height = 0;
+
+
+static int diff_rect_area(const struct diff_rect *r)
+{
+	return (r->x1 - r->x0 + 1) * (r->y1 - r->y0 + 1);
+}
+
+static void diff_rect_merge(struct diff_rect *r, const struct diff_rect *o)
+{
+	if (o->x0 < r->x0) r->x0 = o->x0;
+	if (o->x1 > r->x1) r->x1 = o->x1;
+	if (o->y0 < r->y0) r->y0 = o->y0;
+	if (o->y1 > r->y1) r->y1 = o->y1;
+}
+
+/**
+ *  @brief: extra bytes sent if a and b are pushed as one rectangle
+ */
+static int diff_merge_delta(const struct diff_rect *a, const struct diff_rect *b)
+{
+	struct diff_rect m = *a;
+
+	diff_rect_merge(&m, b);
+	return diff_rect_area(&m) - diff_rect_area(a) - diff_rect_area(b);
+}
+
+/**
+ *  @brief: add a changed row segment, growing an existing rectangle when
+ *          that is cheaper than a new window
+ */
+static int diff_add_segment(struct diff_rect *rects, int n, const struct diff_rect *seg)
+{
+	int i, best = -1, best_delta = 0;
+
+	for (i=0; i<n; i++) {
+		int delta = diff_merge_delta(&rects[i], seg);
+
+		if ((best < 0) || (delta < best_delta)) {
+			best = i;
+			best_delta = delta;
+		}
+	}
+
+	if ((best >= 0) && ((best_delta <= EPD_DIFF_WINDOW_COST) || (n == EPD_DIFF_MAX_RECTS))) {
+		diff_rect_merge(&rects[best], seg);
+		return n;
+	}
+
+	rects[n] = *seg;
+	return n + 1;
+}
+
+/**
+ *  @brief: merge rectangle pairs for as long as that saves bytes
+ */
+static int diff_optimize(struct diff_rect *rects, int n)
+{
+	int i, j, bi, bj, best;
+
+	for (;;) {
+		bi = bj = -1;
+		best = EPD_DIFF_WINDOW_COST;
+		for (i=0; i<n; i++) {
+			for (j=i+1; j<n; j++) {
+				int delta = diff_merge_delta(&rects[i], &rects[j]);
+
+				if (delta < best) {
+					best = delta;
+					bi = i;
+					bj = j;
+				}
+			}
+		}
+		if (bi < 0) {
+			return n;
+		}
+		diff_rect_merge(&rects[bi], &rects[bj]);
+		rects[bj] = rects[--n];
+	}
+}
+
+/**
+ *  @brief: find rectangles covering every byte that differs between frame and old
+ */
+static int diff_compute(const uint8_t *frame, const uint8_t *old, struct diff_rect *rects)
+{
+	int x, y, n = 0;
+
+	for (y=0; y<_height; y++) {
+		const uint8_t *a = frame + y * _stride;
+		const uint8_t *b = old + y * _stride;
+		struct diff_rect seg = { .x0 = -1, .y0 = y, .y1 = y };
+
+		if (0 == memcmp(a, b, _stride)) {
+			continue;
+		}
+
+		for (x=0; x<_stride; x++) {
+			if (a[x] == b[x]) {
+				continue;
+			}
+			if ((seg.x0 >= 0) && (x - seg.x1 > EPD_DIFF_SEGMENT_GAP)) {
+				n = diff_add_segment(rects, n, &seg);
+				seg.x0 = -1;
+			}
+			if (seg.x0 < 0) {
+				seg.x0 = x;
+			}
+			seg.x1 = x;
+		}
+		if (seg.x0 >= 0) {
+			n = diff_add_segment(rects, n, &seg);
+		}
+	}
+
+	return diff_optimize(rects, n);
+}
+
+static bool diff_alloc(void)
+{
+	int i, stride = mgos_sys_config_get_epaper_size_x() / 8;
+	int height = mgos_sys_config_get_epaper_size_y();
+
+	if ((stride == _stride) && (height == _height) && _shadow[0] && _shadow[1]) {
+		return true;
+	}
+
+	mgos_epd_diff_reset();
+	for (i=0; i<2; i++) {
+		if (!(_shadow[i] = (uint8_t *) malloc(stride * height))) {
+			LOG(LL_ERROR, ("Could not allocate %d bytes for the frame diff", stride * height));
+			mgos_epd_diff_reset();
+			return false;
+		}
+	}
+	_stride = stride;
+	_height = height;
+
+	return true;
+}
+
+/**
+ *  @brief: Copy the part of frame inside the rectangle, in pixels with x
+ *          on byte boundaries, into shadow
+ */
+static void diff_shadow_update(uint8_t *shadow, const uint8_t *frame, const int x, const int y, const int width, const int height)
+{
+	int bx0 = (x < 0) ? 0 : x / 8;
+	int bx1 = (x + width) / 8 - 1;
+	int y0 = (y < 0) ? 0 : y;
+	int y1 = y + height - 1;
+	int row;
+
+	if (bx1 >= _stride) {
+		bx1 = _stride - 1;
+	}
+	if (y1 >= _height) {
+		y1 = _height - 1;
+	}
+	for (row=y0; (row<=y1) && (bx0<=bx1); row++) {
+		memcpy(shadow + row * _stride + bx0, frame + row * _stride + bx0, bx1 - bx0 + 1);
+	}
+}
+
+
+/**
+ *  @brief: Push a full panel frame, sending only what differs from what the
+ *          current RAM bank already holds. frame is size_x * size_y pixels,
+ *          size_x / 8 bytes per row.
+ *          Returns the number of image bytes sent, or -1 on error.
+ *          Inside a push clip only the clipped part is taken as sent.
+ *          this won't update the display.
+ */
+int mgos_epd_push_diff(const uint8_t *frame)
+{
+	struct diff_rect rects[EPD_DIFF_MAX_RECTS];
+	const int bank = mgos_epd_get_ram_bank();
+	const uint32_t epoch = mgos_epd_get_ram_epoch();
+	int i, n, sent = 0;
+	int cx, cy, cw, ch;
+
+	if (!frame || !diff_alloc()) {
+		return -1;
+	}
+
+	if (_shadow_valid[bank] && (_shadow_epoch[bank] == epoch)) {
+		n = diff_compute(frame, _shadow[bank], rects);
+	} else {
+		rects[0].x0 = 0;
+		rects[0].x1 = _stride - 1;
+		rects[0].y0 = 0;
+		rects[0].y1 = _height - 1;
+		n = 1;
+	}
+
+	for (i=0; i<n; i++) {
+		const struct diff_rect *r = &rects[i];
+
+		mgos_epd_pushFrameBufferStride(frame + r->y0 * _stride + r->x0, _stride,
+			r->x0 * 8, r->y0, (r->x1 - r->x0 + 1) * 8, r->y1 - r->y0 + 1);
+		sent += diff_rect_area(r);
+	}
+	LOG(LL_DEBUG, ("Frame diff: %d rectangles, %d bytes", n, sent));
+
+	if (!mgos_epd_get_push_clip(&cx, &cy, &cw, &ch)) {
+		memcpy(_shadow[bank], frame, _stride * _height);
+		_shadow_valid[bank] = true;
+		_shadow_epoch[bank] = epoch;
+	} else if (_shadow_valid[bank] && (_shadow_epoch[bank] == epoch)) {
+		/* only what got past the clip is in the RAM bank now */
+		diff_shadow_update(_shadow[bank], frame, cx, cy, cw, ch);
+	}
+	/* else the bank is unknown outside the clip, keep the shadow invalid */
+
+	return sent;
+}
+
+/**
+ *  @brief: Drop the frame copies, the next push will be a full one
+ */
+void mgos_epd_diff_reset(void)
+{
+	int i;
+
+	for (i=0; i<2; i++) {
+		free(_shadow[i]);
+		_shadow[i] = NULL;
+		_shadow_valid[i] = false;
+	}
+	_stride = 0;
+	_height = 0;
+}
@@ -0,0 +1,44 @@
+#include "mgos.h"
+#include "mgos_rpc.h"
+#include "epaper.h"
+
+
+/**
+ *  @brief: EPD.Stats -- report the driver counters, {"reset": true} clears them afterwards
+ */
+static void epaper_rpc_stats_handler(struct mg_rpc_request_info *ri, void *cb_arg, struct mg_rpc_frame_info *fi, struct mg_str args)
+{
+	const struct mgos_epd_stats *st = mgos_epd_get_stats();
+	uint32_t refreshes = st->full_refreshes + st->partial_refreshes;
+	bool reset = false;
+
+	json_scanf(args.p, args.len, ri->args_fmt, &reset);
+
+	mg_rpc_send_responsef(ri, "{spi_txns: %u, spi_bytes: %u, dc_toggles: %u, busy_wait_ms: %u, "
+		"full_refreshes: %u, partial_refreshes: %u, "
+		"last_refresh_ms: %u, max_refresh_ms: %u, avg_refresh_ms: %u}",
+		st->spi_txns, st->spi_bytes, st->dc_toggles, st->busy_wait_ms,
+		st->full_refreshes, st->partial_refreshes,
+		st->last_refresh_ms, st->max_refresh_ms, refreshes ? (st->total_refresh_ms / refreshes) : 0);
+
+	if (reset) {
+		mgos_epd_clear_stats();
+	}
+
+	(void) cb_arg;
+	(void) fi;
+}
+
+
+bool mgos_epd_rpc_init(void)
+{
+	struct mg_rpc *c = mgos_rpc_get_global();
+
+	if (c == NULL) {
+		LOG(LL_ERROR, ("RPC is not available, EPD.Stats not registered"));
+		return false;
+	}
+	mg_rpc_add_handler(c, "EPD.Stats", "{reset: %B}", epaper_rpc_stats_handler, NULL);
+
+	return true;
+}
@@ -0,0 +1,124 @@
+/*
+ * Bit helpers shared by the 1bpp routines of libs/epaper.
+ * Bitmaps are MSB first: pixel 0 of a row is bit 7 of byte 0, which is
+ * also the order the controller RAM takes them in. Words are assembled
+ * big endian so that shifting a word moves pixels left or right.
+ */
+#ifndef _MGOS_LIBS_EPAPER_EPDBITS_H
+#define _MGOS_LIBS_EPAPER_EPDBITS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "epdpaint.h"
+
+static inline uint32_t epd_bits_load32(const uint8_t *p)
+{
+	return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) | ((uint32_t) p[2] << 8) | p[3];
+}
+
+static inline void epd_bits_store32(uint8_t *p, const uint32_t v)
+{
+	p[0] = v >> 24;
+	p[1] = v >> 16;
+	p[2] = v >> 8;
+	p[3] = v;
+}
+
+/**
+ *  @brief: 32 bits starting at bit offset `bit` of row, MSB first.
+ *          touches only the bytes holding those bits.
+ */
+static inline uint32_t epd_bits_get32(const uint8_t *row, const int bit)
+{
+	const uint8_t *p = &row[bit >> 3];
+	const int sh = bit & 0x07;
+	uint32_t v = epd_bits_load32(p);
+
+	if (sh) {
+		v = (v << sh) | (p[4] >> (8 - sh));
+	}
+	return v;
+}
+
+/**
+ *  @brief: 8 bits starting at bit offset `bit` of row, MSB first.
+ *          bytes outside [lo, hi] are never read and count as 0,
+ *          bit may be negative.
+ */
+static inline uint8_t epd_bits_get8(const uint8_t *row, const int bit, const int lo, const int hi)
+{
+	const int i = bit >> 3;
+	const int sh = bit & 0x07;
+	const uint8_t a = ((i >= lo) && (i <= hi)) ? row[i] : 0;
+	uint8_t b;
+
+	if (!sh) {
+		return a;
+	}
+	b = ((i + 1 >= lo) && (i + 1 <= hi)) ? row[i + 1] : 0;
+	return (a << sh) | (b >> (8 - sh));
+}
+
+/**
+ *  @brief: n (1..32) bits starting at bit offset `bit` of p, MSB first and
+ *          left aligned in the result. Unlike epd_bits_get32() it never
+ *          reads past the last byte holding those bits, so it is safe on
+ *          the end of a packed bitmap.
+ */
+static inline uint32_t epd_bits_fetch(const uint8_t *p, const uint32_t bit, const int n)
+{
+	const uint8_t *q = &p[bit >> 3];
+	const int sh = bit & 0x07;
+	const int bytes = (sh + n + 7) >> 3;
+	uint64_t v = 0;
+	int i;
+
+	for (i = 0; i < bytes; i++) {
+		v |= (uint64_t) q[i] << (56 - 8 * i);
+	}
+	return (uint32_t) ((v << sh) >> 32) & (0xFFFFFFFF << (32 - n));
+}
+
+/**
+ *  @brief: set (colored) or clear the destination bits at dst bit offset
+ *          `bit` wherever the left aligned n (1..32) bits of v are set
+ */
+static inline void epd_bits_merge(uint8_t *dst, const int bit, const uint32_t v, const int n, const bool colored)
+{
+	uint8_t *q = &dst[bit >> 3];
+	const int sh = bit & 0x07;
+	const int bytes = (sh + n + 7) >> 3;
+	const uint64_t w = ((uint64_t) v << 32) >> sh;
+	int i;
+
+	for (i = 0; i < bytes; i++) {
+		const uint8_t b = w >> (56 - 8 * i);
+
+		if (colored) {
+			q[i] |= b;
+		} else {
+			q[i] &= ~b;
+		}
+	}
+}
+
+/**
+ *  @brief: combine source into destination under mask, returns the new value
+ */
+static inline uint32_t epd_bits_rop(const uint32_t d, const uint32_t s, const uint32_t m, const enum mgos_epd_rop_t rop)
+{
+	uint32_t r;
+
+	switch (rop) {
+	case EPD_ROP_OR:     r = d | s;  break;
+	case EPD_ROP_AND:    r = d & s;  break;
+	case EPD_ROP_XOR:    r = d ^ s;  break;
+	case EPD_ROP_NOT:    r = ~s;     break;
+	case EPD_ROP_ANDNOT: r = d & ~s; break;
+	default:             r = s;      break;
+	}
+	return (d & ~m) | (r & m);
+}
+
+#endif // _MGOS_LIBS_EPAPER_EPDBITS_H
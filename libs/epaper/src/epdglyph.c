@@ -0,0 +1,142 @@
+#include "mgos.h"
+#include "mgos_config.h"
+#include "common/queue.h"
+
+#include "epdglyph.h"
+
+/*
+ * Rotated glyph cache.
+ * Drawing text on a rotated buffer used to go through mgos_epdDrawPixel()
+ * for every glyph pixel. Instead each glyph is rotated once into a bitmap
+ * in buffer orientation, which mgos_epd_blit() then merges row by row.
+ * Entries are kept most recently used first and the least recently used
+ * ones go when epaper.glyph_cache_size bytes would be exceeded.
+ */
+
+struct glyph_cache_entry {
+	TAILQ_ENTRY(glyph_cache_entry) entries;
+	const sFONT *font;
+	char c;
+	enum mgos_epd_rotate_t rotate;
+	size_t size;
+	struct epd_glyph glyph;
+	uint8_t bits[];
+};
+
+static TAILQ_HEAD(glyph_cache_head, glyph_cache_entry) _cache = TAILQ_HEAD_INITIALIZER(_cache);
+static size_t _cache_used = 0;
+
+
+static void glyph_cache_evict(struct glyph_cache_entry *e)
+{
+	TAILQ_REMOVE(&_cache, e, entries);
+	_cache_used -= e->size;
+	free(e);
+}
+
+/**
+ *  @brief: rotate the unrotated w x h glyph into e->bits, reading it a
+ *          row at a time from the decoder
+ */
+static void glyph_cache_rotate(struct glyph_cache_entry *e, struct sfont_row_decoder *d,
+	const int w, const int h)
+{
+	struct epd_glyph *g = &e->glyph;
+	uint8_t src[SFONT_ROW_MAX];
+	int i, j, bx, by;
+
+	for (j = 0; j < h; j++) {
+		sfont_glyph_row(d, src);
+		for (i = 0; i < w; i++) {
+			if (!(src[i >> 3] & (0x80 >> (i & 0x07)))) {
+				continue;
+			}
+			switch (e->rotate) {
+			case ROTATE_90:
+				bx = h - 1 - j;
+				by = i;
+				break;
+			case ROTATE_180:
+				bx = w - 1 - i;
+				by = h - 1 - j;
+				break;
+			case ROTATE_270:
+				bx = j;
+				by = w - 1 - i;
+				break;
+			default:
+				bx = i;
+				by = j;
+				break;
+			}
+			e->bits[by * g->stride + (bx >> 3)] |= 0x80 >> (bx & 0x07);
+		}
+	}
+}
+
+bool mgos_epd_glyph_cache_get(const sFONT *font, const char c, const enum mgos_epd_rotate_t rotate,
+	struct epd_glyph *glyph)
+{
+	const size_t cap = mgos_sys_config_get_epaper_glyph_cache_size();
+	const bool swapped = (rotate == ROTATE_90) || (rotate == ROTATE_270);
+	struct sfont_row_decoder d;
+	struct glyph_cache_entry *e;
+	int width, height, gstride;
+	size_t size;
+
+	TAILQ_FOREACH(e, &_cache, entries) {
+		if ((e->font == font) && (e->c == c) && (e->rotate == rotate)) {
+			if (e != TAILQ_FIRST(&_cache)) {
+				TAILQ_REMOVE(&_cache, e, entries);
+				TAILQ_INSERT_HEAD(&_cache, e, entries);
+			}
+			*glyph = e->glyph;
+			return true;
+		}
+	}
+
+	if (!sfont_glyph_begin(&d, font, c)) {
+		return false;
+	}
+	width = swapped ? font->Height : font->Width;
+	height = swapped ? font->Width : font->Height;
+	gstride = (width + 7) >> 3;
+	size = sizeof(*e) + gstride * height;
+	if (size > cap) {
+		return false;
+	}
+
+	while ((_cache_used + size > cap) && !TAILQ_EMPTY(&_cache)) {
+		glyph_cache_evict(TAILQ_LAST(&_cache, glyph_cache_head));
+	}
+
+	e = calloc(1, size);
+	if (!e) {
+		return false;
+	}
+	e->font = font;
+	e->c = c;
+	e->rotate = rotate;
+	e->size = size;
+	e->glyph.width = width;
+	e->glyph.height = height;
+	e->glyph.stride = gstride;
+	e->glyph.bits = e->bits;
+	glyph_cache_rotate(e, &d, font->Width, font->Height);
+
+	TAILQ_INSERT_HEAD(&_cache, e, entries);
+	_cache_used += size;
+
+	*glyph = e->glyph;
+	return true;
+}
+
+/**
+ *  @brief: drop all cached glyphs, e.g. to get the memory back
+ */
+void mgos_epd_glyph_cache_flush(void)
+{
+	while (!TAILQ_EMPTY(&_cache)) {
+		glyph_cache_evict(TAILQ_FIRST(&_cache));
+	}
+}
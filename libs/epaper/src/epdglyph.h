@@ -0,0 +1,28 @@
+/*
+ * Cache of sFONT glyphs pre-rotated for the frame buffer orientation.
+ * Internal to libs/epaper, used by epdpaint.c.
+ */
+#ifndef _MGOS_LIBS_EPAPER_EPDGLYPH_H
+#define _MGOS_LIBS_EPAPER_EPDGLYPH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "fonts.h"
+#include "epdpaint.h"
+
+struct epd_glyph {
+	uint16_t width, height;			// in absolute buffer pixels
+	uint16_t stride;				// bytes per row of bits
+	const uint8_t *bits;			// 1bpp, MSB first
+};
+
+/**
+ *  @brief: glyph of the charactor c rotated by rotate, built on first use
+ *          from the font, raw or compressed.
+ *          returns false if it doesn't fit in the cache.
+ */
+bool mgos_epd_glyph_cache_get(const sFONT *font, const char c, const enum mgos_epd_rotate_t rotate,
+	struct epd_glyph *glyph);
+
+#endif // _MGOS_LIBS_EPAPER_EPDGLYPH_H
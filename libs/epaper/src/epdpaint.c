@@ -29,39 +29,314 @@
 #include "epdpaint.h"
 
 #include "gfxfont.h"
+#include "epdbits.h"
+#include "epdglyph.h"
 
 
-struct {
+struct window {
 	int x0;
 	int y0;
 	int x1;
 	int y1;
 	int color;
-} window;
+};
 
 static int _width=0;
 static int _height=0;
-static struct window clip_window;
 
 static uint8_t *_image=NULL;
 static enum mgos_epd_rotate_t _rotate = ROTATE_0;
+static bool _text_opaque = false;
+
+/*
+ * Damage tracking.
+ * Every frame buffer handed to mgos_epd_setFrameBuffer() gets a surface
+ * that collects the bounding box of pixels that actually changed, in
+ * absolute (unrotated) buffer coordinates. mgos_epd_pushDirty() sends only
+ * that box. The controller swaps its two RAM banks on every refresh, so
+ * each bank keeps its own list of damage it has not received yet.
+ */
+#define EPD_PAINT_SURFACES		4
+
+struct paint_surface {
+	uint8_t *image;
+	int width, height;				// geometry the damage refers to
+	struct window dirty;			// changed since the last push
+	struct window pending[2];		// not yet in RAM bank 0 / 1
+	bool pushed;
+	int target_x, target_y;
+	uint32_t epoch;
+	uint32_t used;
+};
+
+static struct paint_surface _surfaces[EPD_PAINT_SURFACES];
+static struct paint_surface *_surface = NULL;
+static uint32_t _surface_use = 0;
 
 //
 //
 static void mgos_epd_drawCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t cornername, const int colored);
 
 
+static void window_set_empty(struct window *w)
+{
+	w->x0 = w->y0 = 0;
+	w->x1 = w->y1 = -1;
+}
+
+static bool window_is_empty(const struct window *w)
+{
+	return (w->x1 < w->x0) || (w->y1 < w->y0);
+}
+
+static void window_add(struct window *w, const int x0, const int y0, const int x1, const int y1)
+{
+	if (window_is_empty(w)) {
+		w->x0 = x0;
+		w->y0 = y0;
+		w->x1 = x1;
+		w->y1 = y1;
+		return;
+	}
+	if (x0 < w->x0) w->x0 = x0;
+	if (y0 < w->y0) w->y0 = y0;
+	if (x1 > w->x1) w->x1 = x1;
+	if (y1 > w->y1) w->y1 = y1;
+}
+
+static void window_union(struct window *w, const struct window *other)
+{
+	if (!window_is_empty(other)) {
+		window_add(w, other->x0, other->y0, other->x1, other->y1);
+	}
+}
+
+/**
+ *  @brief: take o away from w as far as the rest is still a rectangle,
+ *          o has to span w's whole width or height
+ */
+static void window_subtract(struct window *w, const struct window *o)
+{
+	if (window_is_empty(w) || (o->x0 > w->x1) || (o->x1 < w->x0) || (o->y0 > w->y1) || (o->y1 < w->y0)) {
+		return;
+	}
+	if ((o->x0 <= w->x0) && (o->x1 >= w->x1)) {
+		if ((o->y0 <= w->y0) && (o->y1 >= w->y1)) {
+			window_set_empty(w);
+		} else if (o->y0 <= w->y0) {
+			w->y0 = o->y1 + 1;
+		} else if (o->y1 >= w->y1) {
+			w->y1 = o->y0 - 1;
+		}
+	} else if ((o->y0 <= w->y0) && (o->y1 >= w->y1)) {
+		if (o->x0 <= w->x0) {
+			w->x0 = o->x1 + 1;
+		} else if (o->x1 >= w->x1) {
+			w->x1 = o->x0 - 1;
+		}
+	}
+}
+
+/**
+ *  @brief: record damage in absolute buffer coordinates
+ */
+static inline void mgos_epd_dirty_add(const int x0, const int y0, const int x1, const int y1)
+{
+	if (_surface) {
+		window_add(&_surface->dirty, x0, y0, x1, y1);
+	}
+}
+
+/**
+ *  @brief: the whole buffer is damaged and nothing is known to be in RAM
+ */
+static void mgos_epd_surface_reset(struct paint_surface *s)
+{
+	s->width = _width;
+	s->height = _height;
+	window_set_empty(&s->dirty);
+	if ((_width > 0) && (_height > 0)) {
+		window_add(&s->dirty, 0, 0, _width - 1, _height - 1);
+	}
+	window_set_empty(&s->pending[0]);
+	window_set_empty(&s->pending[1]);
+	s->pushed = false;
+}
+
+
+/**
+ *  @brief: map rotated coordinates to absolute buffer coordinates.
+ *          returns false if the point is outside the rotated canvas.
+ */
+static inline bool mgos_epd_rotate_point(const int x, const int y, int *ax, int *ay)
+{
+	if ((x < 0) || (y < 0)) {
+		return false;
+	}
+
+	switch (_rotate) {
+	case ROTATE_90:
+		if ((x >= _height) || (y >= _width)) {
+			return false;
+		}
+		*ax = _width - 1 - y;
+		*ay = x;
+		break;
+	case ROTATE_180:
+		if ((x >= _width) || (y >= _height)) {
+			return false;
+		}
+		*ax = _width - 1 - x;
+		*ay = _height - 1 - y;
+		break;
+	case ROTATE_270:
+		if ((x >= _height) || (y >= _width)) {
+			return false;
+		}
+		*ax = y;
+		*ay = _height - 1 - x;
+		break;
+	default:
+		if ((x >= _width) || (y >= _height)) {
+			return false;
+		}
+		*ax = x;
+		*ay = y;
+		break;
+	}
+	return true;
+}
+
+/**
+ *  @brief: clip a rectangle given in rotated coordinates (corners inclusive,
+ *          any order) and turn it into an absolute buffer rectangle.
+ *          returns false if nothing is left.
+ */
+static bool mgos_epd_rotate_rect(int x0, int y0, int x1, int y1, struct window *r)
+{
+	const bool swapped = (_rotate == ROTATE_90) || (_rotate == ROTATE_270);
+	const int w = swapped ? _height : _width;
+	const int h = swapped ? _width : _height;
+	int ax0 = 0, ay0 = 0, ax1 = 0, ay1 = 0, t;
+
+	if (x0 > x1) { t = x0; x0 = x1; x1 = t; }
+	if (y0 > y1) { t = y0; y0 = y1; y1 = t; }
+	if (x0 < 0) x0 = 0;
+	if (y0 < 0) y0 = 0;
+	if (x1 >= w) x1 = w - 1;
+	if (y1 >= h) y1 = h - 1;
+	if ((x0 > x1) || (y0 > y1)) {
+		return false;
+	}
+
+	mgos_epd_rotate_point(x0, y0, &ax0, &ay0);
+	mgos_epd_rotate_point(x1, y1, &ax1, &ay1);
+	r->x0 = (ax0 < ax1) ? ax0 : ax1;
+	r->x1 = (ax0 < ax1) ? ax1 : ax0;
+	r->y0 = (ay0 < ay1) ? ay0 : ay1;
+	r->y1 = (ay0 < ay1) ? ay1 : ay0;
+	return true;
+}
+
+/**
+ *  @brief: write the bits selected by mask in one byte.
+ *          returns true if the byte changed.
+ */
+static inline bool mgos_epd_fill_byte(uint8_t *p, const uint8_t mask, const uint8_t value)
+{
+	const uint8_t v = (*p & ~mask) | (value & mask);
+
+	if (v == *p) {
+		return false;
+	}
+	*p = v;
+	return true;
+}
+
+/**
+ *  @brief: fill absolute pixels x0..x1 of row y, both already clipped.
+ *          whole bytes go through memset, the ends through edge masks.
+ *          only the bytes that actually change are marked dirty.
+ */
+static void mgos_epd_fill_span(const int x0, const int x1, const int y, const int colored)
+{
+	uint8_t *row = &_image[y * (_width >> 3)];
+	const uint8_t value = ((IF_INVERT_COLOR && colored) || (!IF_INVERT_COLOR && !colored)) ? 0xFF : 0x00;
+	const int b0 = x0 >> 3, b1 = x1 >> 3;
+	const uint8_t lmask = 0xFF >> (x0 & 0x07);
+	const uint8_t rmask = 0xFF << (7 - (x1 & 0x07));
+	int first = -1, last = -1;
+	int i, j;
+
+	if (b0 == b1) {
+		if (mgos_epd_fill_byte(&row[b0], lmask & rmask, value)) {
+			first = last = b0;
+		}
+	} else {
+		if (mgos_epd_fill_byte(&row[b0], lmask, value)) {
+			first = last = b0;
+		}
+
+		/* skip what is already there, then memset the changed middle */
+		for (i = b0 + 1; (i < b1) && (row[i] == value); i++);
+		if (i < b1) {
+			for (j = b1 - 1; row[j] == value; j--);
+			memset(&row[i], value, j - i + 1);
+			if (first < 0) {
+				first = i;
+			}
+			last = j;
+		}
+
+		if (mgos_epd_fill_byte(&row[b1], rmask, value)) {
+			if (first < 0) {
+				first = b1;
+			}
+			last = b1;
+		}
+	}
+
+	if (first >= 0) {
+		mgos_epd_dirty_add((first << 3) > x0 ? (first << 3) : x0, y,
+			((last << 3) + 7) < x1 ? ((last << 3) + 7) : x1, y);
+	}
+}
+
+/**
+ *  @brief: fill an absolute, clipped rectangle span by span
+ */
+static void mgos_epd_fill_window(const struct window *r, const int colored)
+{
+	int y;
+
+	for (y = r->y0; y <= r->y1; y++) {
+		mgos_epd_fill_span(r->x0, r->x1, y, colored);
+	}
+}
+
+/**
+ *  @brief: fill a rectangle given in rotated coordinates, corners inclusive.
+ *          rotation and clipping are resolved once for the whole primitive.
+ */
+static void mgos_epd_fill_rect(const int x0, const int y0, const int x1, const int y1, const int colored)
+{
+	struct window r;
+
+	if (_image && mgos_epd_rotate_rect(x0, y0, x1, y1, &r)) {
+		mgos_epd_fill_window(&r, colored);
+	}
+}
+
+
 /**
  *  @brief: clear the image
  */
 void mgos_epd_clear(const int colored)
 {
-	int x, y;
+	struct window r = { 0, 0, _width - 1, _height - 1, colored };
 
-	for (x = 0; x < _width; x++) {
-		for (y = 0; y < _height; y++) {
-			mgos_epd_draw_absolute_pixel(x, y, colored);
-		}
+	if (_image && (_width > 0) && (_height > 0)) {
+		mgos_epd_fill_window(&r, colored);
 	}
 }
 
@@ -75,19 +350,26 @@ void mgos_epd_draw_absolute_pixel(const int x, const int y, const int colored)
 		return;
 	}
 
+	uint8_t *p = &_image[(x + y * _width) >> 3];
+	const uint8_t old = *p;
+
 	if (IF_INVERT_COLOR) {
 		if (colored) {
-			_image[(x + y * _width) >> 3] |= (0x80 >> (x & 0x07));
+			*p |= (0x80 >> (x & 0x07));
 		} else {
-			_image[(x + y * _width) >> 3] &= ~((0x80 >> (x & 0x07)));
+			*p &= ~((0x80 >> (x & 0x07)));
 		}
 	} else {
 		if (colored) {
-			_image[(x + y * _width) >> 3] &= ~(0x80 >> (x & 0x07));
+			*p &= ~(0x80 >> (x & 0x07));
 		} else {
-			_image[(x + y * _width) >> 3] |= (0x80 >> (x & 0x07));
+			*p |= (0x80 >> (x & 0x07));
 		}
 	}
+
+	if (*p != old) {
+		mgos_epd_dirty_add(x, y, x, y);
+	}
 }
 
 /**
@@ -95,36 +377,123 @@ void mgos_epd_draw_absolute_pixel(const int x, const int y, const int colored)
  */
 void mgos_epdDrawPixel(const int x, const int y, const int colored)
 {
-	int rotated_x = x, rotated_y = y;
+	int rotated_x, rotated_y;
 
-	if ((x < 0) || (y < 0)) {
+	if (mgos_epd_rotate_point(x, y, &rotated_x, &rotated_y)) {
+		mgos_epd_draw_absolute_pixel(rotated_x, rotated_y, colored);
+	}
+}
+
+
+/**
+ *  @brief: combine a w x h block of a 1bpp bitmap into the frame buffer at
+ *          absolute (x, y), not affected by the rotate parameter.
+ *          src rows are src_stride bytes apart and the block starts at bit
+ *          src_x of each row. mask, if given, has the same layout as src;
+ *          only pixels whose mask bit is set are touched.
+ *          rows are processed 32 bits at a time with the source shifted
+ *          into place, the partial bytes at either end go byte by byte.
+ */
+void mgos_epd_blit(const int x, const int y, const uint8_t *src, const int src_stride, const int src_x,
+	const int w, const int h, const uint8_t *mask, const enum mgos_epd_rop_t rop)
+{
+	int dx0 = x, dy0 = y, dx1 = x + w - 1, dy1 = y + h - 1;
+	int sx = src_x, sy = 0;
+	int stride = _width >> 3;
+	int cx0 = stride, cx1 = -1, cy0 = _height, cy1 = -1;
+	int row;
+
+	if (!_image || !src || (src_x < 0) || (w <= 0) || (h <= 0)) {
 		return;
 	}
 
-	if (_rotate == ROTATE_0) {
-		if ((x >= _width) || (y >= _height)) {
-			return;
+	/* clip to the buffer */
+	if (dx0 < 0) { sx -= dx0; dx0 = 0; }
+	if (dy0 < 0) { sy -= dy0; dy0 = 0; }
+	if (dx1 >= _width) dx1 = _width - 1;
+	if (dy1 >= _height) dy1 = _height - 1;
+	if ((dx0 > dx1) || (dy0 > dy1)) {
+		return;
+	}
+
+	/* source bytes that may be read, and source bit = dest bit + delta */
+	const int lo = sx >> 3;
+	const int hi = (sx + dx1 - dx0) >> 3;
+	const int delta = sx - dx0;
+	const int bend = dx1 >> 3;
+	const uint8_t lmask = 0xFF >> (dx0 & 0x07);
+	const uint8_t rmask = 0xFF << (7 - (dx1 & 0x07));
+
+	for (row = dy0; row <= dy1; row++, sy++) {
+		uint8_t *d = &_image[row * stride];
+		const uint8_t *s = &src[sy * src_stride];
+		const uint8_t *m = mask ? &mask[sy * src_stride] : NULL;
+		int b = dx0 >> 3;
+		int last = (rmask == 0xFF) ? bend : bend - 1;
+		int first_changed = -1, last_changed = -1;
+		uint8_t bm, old;
+
+		/* leading partial byte, or the only byte */
+		if ((lmask != 0xFF) || (b == bend)) {
+			bm = (b == bend) ? (lmask & rmask) : lmask;
+			if (m) {
+				bm &= epd_bits_get8(m, b * 8 + delta, lo, hi);
+			}
+			old = d[b];
+			d[b] = epd_bits_rop(old, epd_bits_get8(s, b * 8 + delta, lo, hi), bm, rop);
+			if (d[b] != old) {
+				first_changed = last_changed = b;
+			}
+			if (b == bend) {
+				goto row_done;
+			}
+			b++;
 		}
-	} else if (_rotate == ROTATE_90) {
-		if ((x >= _height) || (y >= _width)) {
-		  return;
+
+		/* whole words */
+		for (; b + 3 <= last; b += 4) {
+			const uint32_t od = epd_bits_load32(&d[b]);
+			const uint32_t wm = m ? epd_bits_get32(m, b * 8 + delta) : 0xFFFFFFFF;
+			const uint32_t nd = epd_bits_rop(od, epd_bits_get32(s, b * 8 + delta), wm, rop);
+
+			if (nd != od) {
+				epd_bits_store32(&d[b], nd);
+				if (first_changed < 0) {
+					first_changed = b;
+				}
+				last_changed = b + 3;
+			}
 		}
-		rotated_x = _width - y;
-		rotated_y = x;
-	} else if (_rotate == ROTATE_180) {
-		if ((x >= _width) || (y >= _height)) {
-		  return;
+
+		/* whole bytes left over, then the trailing partial byte */
+		for (; b <= bend; b++) {
+			bm = (b > last) ? rmask : 0xFF;
+			if (m) {
+				bm &= epd_bits_get8(m, b * 8 + delta, lo, hi);
+			}
+			old = d[b];
+			d[b] = epd_bits_rop(old, epd_bits_get8(s, b * 8 + delta, lo, hi), bm, rop);
+			if (d[b] != old) {
+				if (first_changed < 0) {
+					first_changed = b;
+				}
+				last_changed = b;
+			}
 		}
-		rotated_x = _width - x;
-		rotated_y = _height - y;
-	} else if (_rotate == ROTATE_270) {
-		if ((x >= _height) || (y >= _width)) {
-		  return;
+
+row_done:
+		if (first_changed >= 0) {
+			if (first_changed < cx0) cx0 = first_changed;
+			if (last_changed > cx1) cx1 = last_changed;
+			if (row < cy0) cy0 = row;
+			cy1 = row;
 		}
-		rotated_x = y;
-		rotated_y = _height - x;
 	}
-	mgos_epd_draw_absolute_pixel(rotated_x, rotated_y, colored);
+
+	if (cx1 >= 0) {
+		mgos_epd_dirty_add((cx0 << 3) > dx0 ? (cx0 << 3) : dx0, cy0,
+			((cx1 << 3) + 7) < dx1 ? ((cx1 << 3) + 7) : dx1, cy1);
+	}
 }
 
 
@@ -138,7 +507,32 @@ uint8_t* mgos_epd_getFrameBuffer(void)
 
 void mgos_epd_setFrameBuffer(uint8_t* image)
 {
+	struct paint_surface *s, *lru = &_surfaces[0];
+	int i;
+
 	_image = image;
+	_surface = NULL;
+	if (image == NULL) {
+		return;
+	}
+
+	for (i=0; i < EPD_PAINT_SURFACES; i++) {
+		s = &_surfaces[i];
+		if (s->image == image) {
+			_surface = s;
+			break;
+		}
+		if (s->used < lru->used) {
+			lru = s;
+		}
+	}
+
+	if (_surface == NULL) {
+		_surface = lru;
+		_surface->image = image;
+		mgos_epd_surface_reset(_surface);
+	}
+	_surface->used = ++_surface_use;
 }
 
 int mgos_epd_get_width(void)
@@ -149,6 +543,9 @@ int mgos_epd_get_width(void)
 void mgos_epd_set_width(const int width)
 {
 	_width = (width & 0x07) ? (width + 8 - (width & 0x07)) : width;
+	if (_surface && (_surface->width != _width)) {
+		mgos_epd_surface_reset(_surface);
+	}
 }
 
 int mgos_epd_get_height(void)
@@ -159,6 +556,9 @@ int mgos_epd_get_height(void)
 void mgos_epd_set_height(const int height)
 {
 	_height = height;
+	if (_surface && (_surface->height != _height)) {
+		mgos_epd_surface_reset(_surface);
+	}
 }
 
 enum mgos_epd_rotate_t mgos_epd_get_rotate(void)
@@ -173,74 +573,268 @@ void mgos_epd_set_rotate(const enum mgos_epd_rotate_t rotate)
 
 
 
-void mgos_epd_print(uint16_t x0, uint16_t y0, char *string)
+/**
+ *  @brief: bounding box of the pixels changed since the last push,
+ *          in absolute buffer coordinates, x and width snapped to 8 pixels.
+ *          Returns false if nothing changed.
+ */
+bool mgos_epd_get_dirty(int *x, int *y, int *w, int *h)
 {
-	uint16_t pixelline_width=0;
-	uint8_t *linebuffer;
-	uint16_t lines;
-	uint8_t pixelcolor = 0;
+	struct window d;
 
-	pixelline_width = (mgos_ili9341_getStringWidth(string)+ 7) & ~0x07;
-	if (pixelline_width==0) {
-		LOG(LL_ERROR, ("getStringWidth returned 0 -- is the font set?"));
-		return;
+	if (!_surface || window_is_empty(&_surface->dirty)) {
+		return false;
 	}
+	d = _surface->dirty;
+	d.x0 &= ~0x07;
+	d.x1 |= 0x07;
+
+	if (x) *x = d.x0;
+	if (y) *y = d.y0;
+	if (w) *w = d.x1 - d.x0 + 1;
+	if (h) *h = d.y1 - d.y0 + 1;
+
+	return true;
+}
 
-	lines = mgos_ili9341_getStringHeight(string);
-	if (lines==0) {
-		LOG(LL_ERROR, ("getStringHeight returned 0 -- is the font set?"));
+/**
+ *  @brief: forget the damage, e.g. after pushing the buffer by other means
+ */
+void mgos_epd_clear_dirty(void)
+{
+	if (_surface) {
+		window_set_empty(&_surface->dirty);
+		window_set_empty(&_surface->pending[0]);
+		window_set_empty(&_surface->pending[1]);
+	}
+}
+
+/**
+ *  @brief: push the damaged part of the frame buffer to the frame memory.
+ *          (x, y) is where the buffer's top left corner sits on the panel,
+ *          x must be a multiple of 8. The first push to a new place sends
+ *          the whole buffer. Damage outside the push clip is kept for a
+ *          later push.
+ *          this won't update the display.
+ */
+void mgos_epd_pushDirty(const int x, const int y)
+{
+	struct paint_surface *s = _surface;
+	const int bank = mgos_epd_get_ram_bank();
+	const uint32_t epoch = mgos_epd_get_ram_epoch();
+	struct window r, clip;
+	int stride;
+
+	if (!s || !_image || (_width <= 0) || (_height <= 0)) {
 		return;
 	}
-	LOG(LL_INFO, ("string='%s' at (%d,%d), width=%u height=%u", string, x0, y0, pixelline_width, lines));
 
-	linebuffer = calloc( 1+pixelline_width, 1);
+	if (!s->pushed || (s->target_x != x) || (s->target_y != y) || (s->epoch != epoch) ||
+		(s->width != _width) || (s->height != _height)) {
+		mgos_epd_surface_reset(s);
+		window_add(&s->pending[0], 0, 0, _width - 1, _height - 1);
+		window_add(&s->pending[1], 0, 0, _width - 1, _height - 1);
+		s->pushed = true;
+		s->target_x = x;
+		s->target_y = y;
+		s->epoch = epoch;
+	}
+
+	window_union(&s->pending[0], &s->dirty);
+	window_union(&s->pending[1], &s->dirty);
+	window_set_empty(&s->dirty);
 
-	if (!linebuffer) {
-		LOG(LL_ERROR, ("could not malloc for string='%s' at (%d,%d), width=%u height=%u", string, x0, y0, pixelline_width, lines));
+	r = s->pending[bank];
+	if (window_is_empty(&r)) {
 		return;
 	}
 
-	for (int line=0; line<mgos_ili9341_getStringHeight(string); line++) {
-		int ret;
-		for (int i=0; i<pixelline_width; i++) {
-			linebuffer[i] = (pixelcolor == 0) ? 0xFF : 0;
-		}
+	/* the controller addresses X in bytes */
+	r.x0 &= ~0x07;
+	r.x1 |= 0x07;
+	stride = _width / 8;
+
+	/* what a push clip keeps out doesn't reach the bank, it stays pending */
+	if (mgos_epd_get_push_clip(&clip.x0, &clip.y0, &clip.x1, &clip.y1)) {
+		clip.x0 -= x;
+		clip.y0 -= y;
+		clip.x1 += clip.x0 - 1;
+		clip.y1 += clip.y0 - 1;
+		window_subtract(&s->pending[bank], &clip);
+	} else {
+		window_set_empty(&s->pending[bank]);
+	}
 
-		ret = ili9341_print_fillPixelLine(string, line, linebuffer, pixelcolor);
-		ret = (ret + 7) & ~0x07;
+	mgos_epd_pushFrameBufferStride(&_image[r.y0 * stride + (r.x0 >> 3)], stride,
+		x + r.x0, y + r.y0, r.x1 - r.x0 + 1, r.y1 - r.y0 + 1);
+}
 
-		if (ret != pixelline_width) {
-			LOG(LL_ERROR, ("ili9341_getStringPixelLine returned %d, but we expected %d", ret, pixelline_width));
-		}
-		mgos_epd_pushFrameBuffer(linebuffer, x0, y0+line, pixelline_width, 1);
-//		ili9341_send_pixels(x0, y0+line, x0+pixelline_width-1, y0+line, (uint8_t *)pixelline, pixelline_width*sizeof(uint16_t));
+
+struct print_rows {
+	const struct gfxfont_run *run;
+	int width;
+};
+
+/**
+ *  @brief: rasterize one scanline of a GFXfont text run, black on white
+ */
+static void mgos_epd_print_row(const int row, uint8_t *buf, void *arg)
+{
+	struct print_rows *p = (struct print_rows *) arg;
+
+	memset(buf, 0xFF, p->width / 8);
+	gfxfont_run_fill_line(p->run, row, buf, 0);
+}
+
+/**
+ *  @brief: print a string in the current GFXfont straight to the frame
+ *          memory. The string is laid out once, the text block is
+ *          rasterized into one buffer and sent with a single RAM window;
+ *          if that buffer can't be had the rows are streamed into the
+ *          same window one by one instead.
+ *          this won't update the display.
+ */
+void mgos_epd_print(uint16_t x0, uint16_t y0, const char *string)
+{
+	struct gfxfont_run *run = gfxfont_run_create(string);
+	struct print_rows p;
+	uint8_t *block;
+	int line, stride;
+
+	if (!run || (run->width == 0) || (run->height == 0)) {
+		LOG(LL_ERROR, ("nothing to print -- is the font set?"));
+		gfxfont_run_destroy(&run);
+		return;
+	}
+	LOG(LL_DEBUG, ("string='%s' at (%d,%d), width=%u height=%u", string, x0, y0, run->width, run->height));
+
+	p.run = run;
+	p.width = (run->width + 7) & ~0x07;
+	stride = p.width / 8;
+	block = malloc(stride * run->height);
+	if (!block) {
+		mgos_epd_pushFrameBufferRows(x0, y0, p.width, run->height, mgos_epd_print_row, &p);
+		gfxfont_run_destroy(&run);
+		return;
 	}
-	free(linebuffer);
+
+	for (line=0; line<run->height; line++) {
+		mgos_epd_print_row(line, &block[line * stride], &p);
+	}
+	mgos_epd_pushFrameBuffer(block, x0, y0, p.width, run->height);
+	free(block);
+	gfxfont_run_destroy(&run);
 }
 
 
 /**
- *  @brief: this draws a charactor on the frame buffer but not refresh
+ *  @brief: raster op that puts a glyph's set bits in the given color,
+ *          and with an opaque background its clear bits in the other one
  */
-void mgos_epd_draw_char_at(const int x, const int y, const char ascii_char, const sFONT* const font, const int colored)
+static enum mgos_epd_rop_t mgos_epd_text_rop(const int colored)
+{
+	const bool set = (IF_INVERT_COLOR && colored) || (!IF_INVERT_COLOR && !colored);
+
+	if (_text_opaque) {
+		return set ? EPD_ROP_COPY : EPD_ROP_NOT;
+	}
+	return set ? EPD_ROP_OR : EPD_ROP_ANDNOT;
+}
+
+/**
+ *  @brief: draw a glyph pixel by pixel, used when the buffer is rotated
+ *          and the glyph cache can't take it
+ */
+static void mgos_epd_draw_glyph_pixels(const int x, const int y, struct sfont_row_decoder *d,
+	const sFONT* const font, const int colored)
 {
-	unsigned int char_offset = (ascii_char - ' ') * font->Height * ((font->Width >> 3) + ((font->Width & 0x07) ? 1 : 0));
-	const uint8_t * ptr = &font->table[char_offset];
+	uint8_t row[SFONT_ROW_MAX];
 	int i, j;
 
 	for (j = 0; j < font->Height; j++) {
+		sfont_glyph_row(d, row);
 		for (i = 0; i < font->Width; i++) {
-			if ((*ptr) & (0x80 >> (i & 0x07))) {
+			if (row[i >> 3] & (0x80 >> (i & 0x07))) {
 				mgos_epdDrawPixel(x + i, y + j, colored);
-			}
-			if ((i & 0x07) == 7) {
-				ptr++;
+			} else if (_text_opaque) {
+				mgos_epdDrawPixel(x + i, y + j, !colored);
 			}
 		}
-		if ((font->Width & 0x07) != 0) {
-			ptr++;
+	}
+}
+
+/**
+ *  @brief: with an opaque background text also paints the clear pixels of
+ *          each glyph cell in the other color. off by default.
+ */
+void mgos_epd_set_text_opaque(const bool opaque)
+{
+	_text_opaque = opaque;
+}
+
+bool mgos_epd_get_text_opaque(void)
+{
+	return _text_opaque;
+}
+
+/**
+ *  @brief: draw one glyph cell at rotated (x, y). unrotated buffers take
+ *          the font bitmap directly, or its rows as they are decompressed,
+ *          rotated ones a pre-rotated copy from the glyph cache; only if
+ *          that fails it goes pixel by pixel.
+ */
+static void mgos_epd_draw_glyph(const int x, const int y, const char ascii_char, const sFONT* const font,
+	const int colored, const enum mgos_epd_rop_t rop)
+{
+	struct sfont_row_decoder d;
+	struct epd_glyph g;
+	uint8_t row[SFONT_ROW_MAX];
+	int ax, ay, j;
+
+	if (!sfont_glyph_begin(&d, font, ascii_char)) {
+		return;
+	}
+	if ((_rotate == ROTATE_0) && d.raw) {
+		mgos_epd_blit(x, y, d.p, d.stride, 0, font->Width, font->Height, NULL, rop);
+		return;
+	}
+	if (_rotate == ROTATE_0) {
+		/* compressed glyphs are decoded and blitted a row at a time */
+		for (j = 0; j < font->Height; j++) {
+			sfont_glyph_row(&d, row);
+			mgos_epd_blit(x, y + j, row, d.stride, 0, font->Width, 1, NULL, rop);
 		}
+		return;
+	}
+	if (!mgos_epd_glyph_cache_get(font, ascii_char, _rotate, &g)) {
+		mgos_epd_draw_glyph_pixels(x, y, &d, font, colored);
+		return;
+	}
+
+	/* absolute top left corner of the rotated cell */
+	switch (_rotate) {
+	case ROTATE_90:
+		ax = _width - y - font->Height;
+		ay = x;
+		break;
+	case ROTATE_180:
+		ax = _width - x - font->Width;
+		ay = _height - y - font->Height;
+		break;
+	default:
+		ax = y;
+		ay = _height - x - font->Width;
+		break;
 	}
+	mgos_epd_blit(ax, ay, g.bits, g.stride, 0, g.width, g.height, NULL, rop);
+}
+
+/**
+ *  @brief: this draws a charactor on the frame buffer but not refresh
+ */
+void mgos_epd_draw_char_at(const int x, const int y, const char ascii_char, const sFONT* const font, const int colored)
+{
+	mgos_epd_draw_glyph(x, y, ascii_char, font, colored, mgos_epd_text_rop(colored));
 }
 
 
@@ -249,25 +843,29 @@ void mgos_epd_draw_char_at(const int x, const int y, const char ascii_char, cons
 */
 void mgos_epd_draw_string_at(const int x, const int y, const char* text, const sFONT* const font, const int colored)
 {
-	const char* p_text = text;
-	int counter = 0;
+	const enum mgos_epd_rop_t rop = mgos_epd_text_rop(colored);
+	const bool swapped = (_rotate == ROTATE_90) || (_rotate == ROTATE_270);
+	const int w = swapped ? _height : _width;
+	const int h = swapped ? _width : _height;
 	int refcolumn = x;
-	
-	/* Send the string character by character on EPD */
-	while (*p_text != 0) {
-		/* Display one character on EPD */
-		mgos_epd_draw_char_at(refcolumn, y, *p_text, font, colored);
-		/* Decrement the column position by 16 */
-		refcolumn += font->Width;
-		/* Point on the next character */
-		p_text++;
-		counter++;
+
+	/* nothing to draw if the line is above or below the buffer */
+	if (!text || (y >= h) || (y + font->Height <= 0)) {
+		return;
+	}
+
+	/* each glyph goes in as one blit, row by row */
+	for (; (*text != 0) && (refcolumn < w); text++, refcolumn += font->Width) {
+		if (refcolumn + font->Width > 0) {
+			mgos_epd_draw_glyph(refcolumn, y, *text, font, colored, rop);
+		}
 	}
 }
 
 
 /**
-*  @brief: this draws a line on the frame buffer
+*  @brief: this draws a line on the frame buffer, both ends included.
+*          the pixels a line has in one row are filled as one span.
 */
 void mgos_epd_drawLine(const int x0, const int y0, const int x1, const int y1, const int colored)
 {
@@ -276,20 +874,27 @@ void mgos_epd_drawLine(const int x0, const int y0, const int x1, const int y1, c
 	int sx = (x0 < x1) ? 1 : -1;
 	int dy = (y1 - y0) <= 0 ? (y1 - y0) : (y0 - y1);
 	int sy = (y0 < y1) ? 1 : -1;
-	int err = dx + dy;
+	int err = dx + dy, e2;
 	int cx = x0, cy = y0;
+	int run_x = x0;
 
-	while ((cx != x1) && (cy != y1)) {
-		mgos_epdDrawPixel(cx, cy , colored);
-		if (2 * err >= dy) {     
+	while (!((cx == x1) && (cy == y1))) {
+		const int px = cx;
+
+		e2 = 2 * err;
+		if (e2 >= dy) {
 			err += dy;
 			cx += sx;
 		}
-		if (2 * err <= dx) {
-			err += dx; 
+		if (e2 <= dx) {
+			/* the row is done, its run ends where x was before this step */
+			mgos_epd_fill_rect(run_x, cy, px, cy, colored);
+			err += dx;
 			cy += sy;
+			run_x = cx;
 		}
 	}
+	mgos_epd_fill_rect(run_x, cy, cx, cy, colored);
 }
 
 
@@ -298,9 +903,8 @@ void mgos_epd_drawLine(const int x0, const int y0, const int x1, const int y1, c
 */
 void mgos_epd_draw_horizontal_line(const int x, const int y, const int line_width, const int colored)
 {
-	int i;
-	for (i = x; i < (x + line_width); i++) {
-		mgos_epdDrawPixel(i, y, colored);
+	if (line_width > 0) {
+		mgos_epd_fill_rect(x, y, x + line_width - 1, y, colored);
 	}
 }
 
@@ -310,9 +914,8 @@ void mgos_epd_draw_horizontal_line(const int x, const int y, const int line_widt
 */
 void mgos_epd_draw_vertical_line(const int x, const int y, const int line_height, const int colored)
 {
-	int i;
-	for (i = y; i < (y + line_height); i++) {
-		mgos_epdDrawPixel(x, i, colored);
+	if (line_height > 0) {
+		mgos_epd_fill_rect(x, y, x, y + line_height - 1, colored);
 	}
 }
 
@@ -341,16 +944,7 @@ void mgos_epd_draw_rectangle(const int x0, const int y0, const int x1, const int
 */
 void mgos_epd_draw_filled_rectangle(const int x0, const int y0, const int x1, const int y1, const int colored)
 {
-	int min_x, min_y, max_x, max_y;
-	int i;
-	min_x = (x1 > x0) ? x0 : x1;
-	max_x = (x1 > x0) ? x1 : x0;
-	min_y = (y1 > y0) ? y0 : y1;
-	max_y = (y1 > y0) ? y1 : y0;
-	
-	for (i = min_x; i <= max_x; i++) {
-	  mgos_epd_draw_vertical_line(i, min_y, max_y - min_y + 1, colored);
-	}
+	mgos_epd_fill_rect(x0, y0, x1, y1, colored);
 }
 
 
@@ -396,10 +990,6 @@ void mgos_epd_drawFilledCircle(const int x, const int y, const int radius, const
 	int e2;
 
 	do {
-		mgos_epdDrawPixel(x - x_pos, y + y_pos, colored);
-		mgos_epdDrawPixel(x + x_pos, y + y_pos, colored);
-		mgos_epdDrawPixel(x + x_pos, y - y_pos, colored);
-		mgos_epdDrawPixel(x - x_pos, y - y_pos, colored);
 		mgos_epd_draw_horizontal_line(x + x_pos, y + y_pos, 2 * (-x_pos) + 1, colored);
 		mgos_epd_draw_horizontal_line(x + x_pos, y - y_pos, 2 * (-x_pos) + 1, colored);
 		e2 = err;
@@ -460,10 +1050,10 @@ static void mgos_epd_drawCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t
 void mgos_epd_drawRoundRect(int16_t x0, int16_t y0, uint16_t w, uint16_t h, uint16_t r, const int colored)
 {
 	// draw the straight edges
-	mgos_epd_drawLine(x0+r, y0, x0+w-r, y0, colored);         // Top
-	mgos_epd_drawLine(x0+r, y0+h-1, x0+w-r, y0+h-1, colored); // Bottom
-	mgos_epd_drawLine(x0, y0+r, x0, y0+h-r, colored);         // Left
-	mgos_epd_drawLine(x0+w-1, y0+r, x0+w-1, y0+h-r, colored); // Right
+	mgos_epd_drawLine(x0+r, y0, x0+w-r-1, y0, colored);         // Top
+	mgos_epd_drawLine(x0+r, y0+h-1, x0+w-r-1, y0+h-1, colored); // Bottom
+	mgos_epd_drawLine(x0, y0+r, x0, y0+h-r-1, colored);         // Left
+	mgos_epd_drawLine(x0+w-1, y0+r, x0+w-1, y0+h-r-1, colored); // Right
 
 	// draw four corners
 	mgos_epd_drawCircleHelper(x0+r, y0+r, r, 1, colored);          // Top Left
@@ -502,7 +1092,7 @@ void mgos_epd_fillTriangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, u
     else if(x1 > b) b = x1;
     if(x2 < a)      a = x2;
     else if(x2 > b) b = x2;
-    mgos_epd_drawLine(a, y0, b+1, y0, colored);
+    mgos_epd_draw_horizontal_line(a, y0, b-a+1, colored);
     return;
   }
 
@@ -536,7 +1126,7 @@ void mgos_epd_fillTriangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, u
     b = x0 + (x2 - x0) * (y - y0) / (y2 - y0);
     */
     if(a > b) swap(a,b);
-    mgos_epd_drawLine(a, y, b+1, y, colored);
+    mgos_epd_draw_horizontal_line(a, y, b-a+1, colored);
   }
 
   // For lower part of triangle, find scanline crossings for segments
@@ -553,7 +1143,7 @@ void mgos_epd_fillTriangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, u
     b = x0 + (x2 - x0) * (y - y0) / (y2 - y0);
     */
     if(a > b) swap(a,b);
-    mgos_epd_drawLine(a, y, b+1, y, colored);
+    mgos_epd_draw_horizontal_line(a, y, b-a+1, colored);
   }
 }
 
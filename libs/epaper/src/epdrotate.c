@@ -0,0 +1,117 @@
+#include "mgos.h"
+
+#include "epdrotate.h"
+
+/*
+ * Frame rotation at push time.
+ * 90 and 270 degrees move 8x8 bit blocks through a transpose done on two
+ * 32 bit words, with the block rows (90) or the result rows (270) taken
+ * in reverse. 180 degrees reverses each row with a bit reversal table.
+ * The mapping matches mgos_epdDrawPixel(), so a frame drawn unrotated and
+ * pushed rotated ends up exactly like one drawn on a rotated buffer.
+ */
+
+static const uint8_t _reverse8[256] = {
+#define R2(n)	(n), (n) + 2 * 64, (n) + 1 * 64, (n) + 3 * 64
+#define R4(n)	R2(n), R2((n) + 2 * 16), R2((n) + 1 * 16), R2((n) + 3 * 16)
+#define R6(n)	R4(n), R4((n) + 2 * 4), R4((n) + 1 * 4), R4((n) + 3 * 4)
+	R6(0), R6(2), R6(1), R6(3)
+#undef R6
+#undef R4
+#undef R2
+};
+
+
+uint8_t epd_rotate_reverse8(const uint8_t b)
+{
+	return _reverse8[b];
+}
+
+void epd_rotate_transpose8(const uint8_t *src, const int src_stride, uint8_t *dst, const int dst_stride)
+{
+	uint32_t x, y, t;
+
+	x = ((uint32_t) src[0] << 24) | ((uint32_t) src[src_stride] << 16) |
+		((uint32_t) src[2 * src_stride] << 8) | src[3 * src_stride];
+	y = ((uint32_t) src[4 * src_stride] << 24) | ((uint32_t) src[5 * src_stride] << 16) |
+		((uint32_t) src[6 * src_stride] << 8) | src[7 * src_stride];
+
+	/* swap 1x1, then 2x2 blocks inside each 4x4 quarter, then the 4x4 quarters */
+	t = (x ^ (x >> 7)) & 0x00AA00AA;  x = x ^ t ^ (t << 7);
+	t = (y ^ (y >> 7)) & 0x00AA00AA;  y = y ^ t ^ (t << 7);
+	t = (x ^ (x >> 14)) & 0x0000CCCC; x = x ^ t ^ (t << 14);
+	t = (y ^ (y >> 14)) & 0x0000CCCC; y = y ^ t ^ (t << 14);
+	t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+	y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+	x = t;
+
+	dst[0] = x >> 24;
+	dst[dst_stride] = x >> 16;
+	dst[2 * dst_stride] = x >> 8;
+	dst[3 * dst_stride] = x;
+	dst[4 * dst_stride] = y >> 24;
+	dst[5 * dst_stride] = y >> 16;
+	dst[6 * dst_stride] = y >> 8;
+	dst[7 * dst_stride] = y;
+}
+
+void epd_rotate_size(const int width, const int height, const enum mgos_epd_rotate_t rotate, int *out_width, int *out_height)
+{
+	const bool swapped = (rotate == ROTATE_90) || (rotate == ROTATE_270);
+
+	*out_width = swapped ? height : width;
+	*out_height = swapped ? width : height;
+}
+
+int epd_rotate_band(const uint8_t *frame, const int width, const int height, const enum mgos_epd_rotate_t rotate,
+	const int band, uint8_t *out)
+{
+	const int stride = (width + 7) >> 3;
+	int out_width, out_height, out_stride, rows;
+	int r, b;
+
+	epd_rotate_size(width, height, rotate, &out_width, &out_height);
+	out_stride = (out_width + 7) >> 3;
+	rows = out_height - band * 8;
+	if (rows <= 0) {
+		return 0;
+	}
+	if (rows > 8) {
+		rows = 8;
+	}
+
+	switch (rotate) {
+	case ROTATE_90:
+		/* output rows 8 * band.. come from input byte column band, output
+		 * byte column b from input rows height - 8 - 8 * b.., bottom up */
+		for (b = 0; b < out_stride; b++) {
+			const uint8_t *src = &frame[(height - 1 - 8 * b) * stride + band];
+
+			epd_rotate_transpose8(src, -stride, &out[b], out_stride);
+		}
+		break;
+	case ROTATE_270:
+		/* input byte column stride - 1 - band, read top down, gives the
+		 * output rows bottom up */
+		for (b = 0; b < out_stride; b++) {
+			const uint8_t *src = &frame[8 * b * stride + (stride - 1 - band)];
+
+			epd_rotate_transpose8(src, stride, &out[7 * out_stride + b], -out_stride);
+		}
+		break;
+	case ROTATE_180:
+		for (r = 0; r < rows; r++) {
+			const uint8_t *src = &frame[(height - 1 - (band * 8 + r)) * stride];
+			uint8_t *dst = &out[r * out_stride];
+
+			for (b = 0; b < stride; b++) {
+				dst[b] = _reverse8[src[stride - 1 - b]];
+			}
+		}
+		break;
+	default:
+		memcpy(out, &frame[band * 8 * stride], rows * stride);
+		break;
+	}
+	return rows;
+}
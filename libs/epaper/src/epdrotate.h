@@ -0,0 +1,39 @@
+/*
+ * Rotation of whole 1bpp frames on their way to the controller.
+ * Internal to libs/epaper, used by epaper.c.
+ */
+#ifndef _MGOS_LIBS_EPAPER_EPDROTATE_H
+#define _MGOS_LIBS_EPAPER_EPDROTATE_H
+
+#include <stdint.h>
+
+#include "epdpaint.h"
+
+/**
+ *  @brief: transpose an 8x8 bit block. row i of src is at src[i * src_stride],
+ *          row j of dst gets column j of src, MSB first both ways.
+ */
+void epd_rotate_transpose8(const uint8_t *src, const int src_stride, uint8_t *dst, const int dst_stride);
+
+/**
+ *  @brief: the byte with its bits in reverse order
+ */
+uint8_t epd_rotate_reverse8(const uint8_t b);
+
+/**
+ *  @brief: size of a width x height frame after rotation
+ */
+void epd_rotate_size(const int width, const int height, const enum mgos_epd_rotate_t rotate, int *out_width, int *out_height);
+
+/**
+ *  @brief: rows 8 * band .. 8 * band + 7 of the rotated frame into out,
+ *          out_width / 8 bytes per row. The frame was drawn unrotated,
+ *          width / 8 bytes per row; width must be a multiple of 8, and
+ *          for ROTATE_90 and ROTATE_270 so must height. The result is
+ *          what drawing with mgos_epd_set_rotate(rotate) would have made.
+ *          returns the number of rows written.
+ */
+int epd_rotate_band(const uint8_t *frame, const int width, const int height, const enum mgos_epd_rotate_t rotate,
+	const int band, uint8_t *out);
+
+#endif // _MGOS_LIBS_EPAPER_EPDROTATE_H
@@ -0,0 +1,136 @@
+#include <limits.h>
+#include <string.h>
+
+#include "fonts.h"
+
+/*
+ * Run length compressed sFONT glyphs.
+ * A glyph is its Width x Height pixels read row by row without padding,
+ * as runs that alternate between clear and set, starting with clear. A
+ * run length is a sequence of 4 bit nibbles, high nibble first, that are
+ * added up; 15 means another nibble follows. The last clear run is left
+ * out, a glyph that runs out of nibbles is clear to the end.
+ * Glyphs that would not get smaller are stored raw instead, in the usual
+ * table layout, and have SFONT_RLE_RAW set in their offset.
+ * libs/epaper/host/fontpack writes fonts_rle.c from the raw tables.
+ */
+
+
+static int sfont_rle_nibble(struct sfont_row_decoder *d)
+{
+	int n;
+
+	if (d->p >= d->end) {
+		return -1;
+	}
+	if (d->nibble) {
+		n = *d->p++ & 0x0F;
+	} else {
+		n = *d->p >> 4;
+	}
+	d->nibble ^= 1;
+	return n;
+}
+
+static int sfont_rle_run(struct sfont_row_decoder *d)
+{
+	int len = 0, n;
+
+	do {
+		if ((n = sfont_rle_nibble(d)) < 0) {
+			return -1;
+		}
+		len += n;
+	} while (n == 15);
+	return len;
+}
+
+/**
+ *  @brief: set pixels x .. x + n - 1 of row
+ */
+static void sfont_row_set(uint8_t *row, int x, int n)
+{
+	for (; (n > 0) && (x & 0x07); x++, n--) {
+		row[x >> 3] |= 0x80 >> (x & 0x07);
+	}
+	for (; n >= 8; x += 8, n -= 8) {
+		row[x >> 3] = 0xFF;
+	}
+	if (n > 0) {
+		row[x >> 3] |= (uint8_t) (0xFF00 >> n);
+	}
+}
+
+/**
+ *  @brief: start reading the glyph of c, raw or compressed.
+ *          returns 0 if the font has no such glyph.
+ */
+int sfont_glyph_begin(struct sfont_row_decoder *d, const sFONT *font, const char c)
+{
+	const unsigned char i = (unsigned char) c;
+	uint16_t from, to;
+
+	if ((i < ' ') || (i > '~')) {
+		return 0;
+	}
+	memset(d, 0, sizeof(*d));
+	d->width = font->Width;
+	d->stride = (font->Width + 7) >> 3;
+	if (d->stride > SFONT_ROW_MAX) {
+		return 0;
+	}
+
+	if (font->table) {
+		d->raw = 1;
+		d->p = &font->table[(i - ' ') * font->Height * d->stride];
+		return 1;
+	}
+	if (!font->rle || !font->rle_offsets) {
+		return 0;
+	}
+
+	from = font->rle_offsets[i - ' '];
+	to = font->rle_offsets[i - ' ' + 1] & ~SFONT_RLE_RAW;
+	d->raw = (from & SFONT_RLE_RAW) ? 1 : 0;
+	d->p = &font->rle[from & ~SFONT_RLE_RAW];
+	d->end = &font->rle[to];
+	/* the first run is a clear one */
+	d->color = 1;
+	return 1;
+}
+
+/**
+ *  @brief: the next row of the glyph into row, stride bytes, MSB first
+ */
+void sfont_glyph_row(struct sfont_row_decoder *d, uint8_t *row)
+{
+	int x = 0, n;
+
+	if (d->raw) {
+		memcpy(row, d->p, d->stride);
+		d->p += d->stride;
+		return;
+	}
+
+	memset(row, 0, d->stride);
+	while (x < d->width) {
+		if (d->run == 0) {
+			d->color ^= 1;
+			if ((d->run = sfont_rle_run(d)) < 0) {
+				/* out of data, the rest is clear */
+				d->color = 0;
+				d->run = INT_MAX;
+			}
+			continue;
+		}
+		n = d->width - x;
+		if (n > d->run) {
+			n = d->run;
+		}
+		if (d->color) {
+			sfont_row_set(row, x, n);
+		}
+		x += n;
+		d->run -= n;
+	}
+}
@@ -0,0 +1,489 @@
+/*
+ * Run length compressed copies of the sFONT tables, see font_rle.c.
+ * Generated by libs/epaper/host/fontpack, do not edit.
+ */
+#include <stddef.h>
+
+#include "fonts.h"
+
+static const uint8_t Font12_RLE_Data[912] = {
+	0xA1, 0x61, 0x61, 0x61, 0x61, 0xF5, 0x10, 0x82, 0x12, 0x21, 0x21, 0x31, 0x21, 0x00, 0x14, 0x14,
+	0x28, 0x7C, 0x28, 0x7C, 0x28, 0x50, 0x50, 0x00, 0x00, 0xA1, 0x53, 0x31, 0x61, 0x73, 0x31, 0x21,
+	0x33, 0x61, 0x61, 0x91, 0x51, 0x11, 0x51, 0x82, 0x23, 0x71, 0x51, 0x11, 0x51, 0xF9, 0x24, 0x16,
+	0x15, 0x11, 0x11, 0x12, 0x12, 0x14, 0x21, 0x10, 0xA1, 0x61, 0x61, 0x61, 0xB1, 0x61, 0x51, 0x61,
+	0x61, 0x61, 0x61, 0x61, 0x71, 0x61, 0x91, 0x61, 0x71, 0x61, 0x61, 0x61, 0x61, 0x61, 0x51, 0x61,
+	0xA1, 0x45, 0x41, 0x51, 0x11, 0x41, 0x11, 0xF2, 0x16, 0x16, 0x13, 0x73, 0x16, 0x16, 0x10, 0xFF,
+	0xF7, 0x25, 0x15, 0x25, 0x10, 0xFF, 0x65, 0xFF, 0xF6, 0x25, 0x20, 0xC1, 0x61, 0x51, 0x61, 0x51,
+	0x61, 0x51, 0x61, 0x51, 0x00, 0x38, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x38, 0x00, 0x00, 0x00,
+	0x92, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x45, 0x93, 0x31, 0x31, 0x61, 0x51, 0x51, 0x51, 0x51,
+	0x31, 0x25, 0x93, 0x31, 0x31, 0x61, 0x42, 0x71, 0x61, 0x21, 0x31, 0x33, 0x00, 0x0C, 0x14, 0x14,
+	0x24, 0x44, 0x7E, 0x04, 0x0E, 0x00, 0x00, 0x00, 0x94, 0x31, 0x61, 0x63, 0x71, 0x61, 0x21, 0x31,
+	0x33, 0xA3, 0x31, 0x51, 0x64, 0x31, 0x31, 0x21, 0x31, 0x21, 0x31, 0x33, 0x85, 0x21, 0x31, 0x61,
+	0x51, 0x61, 0x61, 0x51, 0x61, 0x00, 0x38, 0x44, 0x44, 0x38, 0x44, 0x44, 0x44, 0x38, 0x00, 0x00,
+	0x00, 0x93, 0x31, 0x31, 0x21, 0x31, 0x21, 0x31, 0x34, 0x61, 0x51, 0x33, 0xF8, 0x25, 0x2F, 0x42,
+	0x52, 0xF9, 0x25, 0x2F, 0x42, 0x42, 0x51, 0xF3, 0x24, 0x14, 0x24, 0x17, 0x27, 0x17, 0x20, 0xFE,
+	0x59, 0x50, 0xE2, 0x71, 0x72, 0x71, 0x42, 0x41, 0x42, 0xF2, 0x24, 0x12, 0x16, 0x15, 0x15, 0x1C,
+	0x20, 0x38, 0x44, 0x44, 0x4C, 0x54, 0x54, 0x4C, 0x40, 0x44, 0x38, 0x00, 0x00, 0x00, 0x30, 0x10,
+	0x28, 0x28, 0x28, 0x7C, 0x44, 0xEE, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x44, 0x44, 0x78, 0x44, 0x44,
+	0x44, 0xF8, 0x00, 0x00, 0x00, 0x94, 0x21, 0x31, 0x21, 0x61, 0x61, 0x61, 0x61, 0x31, 0x33, 0x00,
+	0xF0, 0x48, 0x44, 0x44, 0x44, 0x44, 0x48, 0xF0, 0x00, 0x00, 0x00, 0x00, 0xFC, 0x44, 0x50, 0x70,
+	0x50, 0x40, 0x44, 0xFC, 0x00, 0x00, 0x00, 0x86, 0x21, 0x31, 0x21, 0x11, 0x43, 0x41, 0x11, 0x41,
+	0x61, 0x53, 0x00, 0x3C, 0x44, 0x40, 0x40, 0x4E, 0x44, 0x44, 0x38, 0x00, 0x00, 0x00, 0x00, 0xEE,
+	0x44, 0x44, 0x7C, 0x44, 0x44, 0x44, 0xEE, 0x00, 0x00, 0x00, 0x85, 0x41, 0x61, 0x61, 0x61, 0x61,
+	0x61, 0x45, 0x94, 0x51, 0x61, 0x61, 0x31, 0x21, 0x31, 0x21, 0x31, 0x21, 0x42, 0x00, 0xEE, 0x44,
+	0x48, 0x50, 0x70, 0x48, 0x44, 0xE6, 0x00, 0x00, 0x00, 0x83, 0x51, 0x61, 0x61, 0x61, 0x61, 0x21,
+	0x31, 0x21, 0x25, 0x00, 0xEE, 0x6C, 0x6C, 0x54, 0x54, 0x44, 0x44, 0xEE, 0x00, 0x00, 0x00, 0x00,
+	0xEE, 0x64, 0x64, 0x54, 0x54, 0x54, 0x4C, 0xEC, 0x00, 0x00, 0x00, 0x00, 0x38, 0x44, 0x44, 0x44,
+	0x44, 0x44, 0x44, 0x38, 0x00, 0x00, 0x00, 0x84, 0x41, 0x21, 0x31, 0x21, 0x31, 0x21, 0x33, 0x41,
+	0x61, 0x53, 0x00, 0x38, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x38, 0x1C, 0x00, 0x00, 0x00, 0xF8,
+	0x44, 0x44, 0x44, 0x78, 0x48, 0x44, 0xE2, 0x00, 0x00, 0x00, 0x00, 0x34, 0x4C, 0x40, 0x38, 0x04,
+	0x04, 0x64, 0x58, 0x00, 0x00, 0x00, 0x78, 0x21, 0x21, 0x31, 0x61, 0x61, 0x61, 0x61, 0x53, 0x00,
+	0xEE, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x38, 0x00, 0x00, 0x00, 0x00, 0xEE, 0x44, 0x44, 0x28,
+	0x28, 0x28, 0x10, 0x10, 0x00, 0x00, 0x00, 0x00, 0xEE, 0x44, 0x44, 0x54, 0x54, 0x54, 0x54, 0x28,
+	0x00, 0x00, 0x00, 0x00, 0xC6, 0x44, 0x28, 0x10, 0x10, 0x28, 0x44, 0xC6, 0x00, 0x00, 0x00, 0x00,
+	0xEE, 0x44, 0x28, 0x28, 0x10, 0x10, 0x10, 0x38, 0x00, 0x00, 0x00, 0x85, 0x21, 0x31, 0x51, 0x51,
+	0x61, 0x51, 0x51, 0x31, 0x25, 0x93, 0x41, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x63, 0x81,
+	0x71, 0x61, 0x61, 0x71, 0x61, 0x71, 0x61, 0x61, 0x93, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61,
+	0x61, 0x43, 0xA1, 0x61, 0x51, 0x11, 0x31, 0x31, 0xFF, 0xFF, 0xF2, 0x70, 0xA1, 0x71, 0xF8, 0x33,
+	0x13, 0x13, 0x42, 0x13, 0x12, 0x13, 0x13, 0x50, 0x00, 0xC0, 0x40, 0x58, 0x64, 0x44, 0x44, 0x44,
+	0xF8, 0x00, 0x00, 0x00, 0xF8, 0x42, 0x13, 0x12, 0x16, 0x16, 0x13, 0x13, 0x30, 0x00, 0x0C, 0x04,
+	0x34, 0x4C, 0x44, 0x44, 0x44, 0x3E, 0x00, 0x00, 0x00, 0xF8, 0x33, 0x13, 0x12, 0x52, 0x16, 0x17,
+	0x40, 0xA3, 0x31, 0x55, 0x31, 0x61, 0x61, 0x61, 0x55, 0x00, 0x00, 0x00, 0x36, 0x4C, 0x44, 0x44,
+	0x44, 0x3C, 0x04, 0x38, 0x00, 0x00, 0xC0, 0x40, 0x58, 0x64, 0x44, 0x44, 0x44, 0xEE, 0x00, 0x00,
+	0x00, 0xA1, 0xB3, 0x61, 0x61, 0x61, 0x61, 0x45, 0xA1, 0xB4, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61,
+	0x33, 0x00, 0xC0, 0x40, 0x5C, 0x48, 0x70, 0x50, 0x48, 0xDC, 0x00, 0x00, 0x00, 0x92, 0x61, 0x61,
+	0x61, 0x61, 0x61, 0x61, 0x45, 0x00, 0x00, 0x00, 0xE8, 0x54, 0x54, 0x54, 0x54, 0xFE, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xD8, 0x64, 0x44, 0x44, 0x44, 0xEE, 0x00, 0x00, 0x00, 0xF8, 0x33, 0x13,
+	0x12, 0x13, 0x12, 0x13, 0x12, 0x13, 0x13, 0x30, 0x00, 0x00, 0x00, 0xD8, 0x64, 0x44, 0x44, 0x44,
+	0x78, 0x40, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x36, 0x4C, 0x44, 0x44, 0x44, 0x3C, 0x04, 0x0E, 0x00,
+	0xF7, 0x21, 0x23, 0x25, 0x16, 0x16, 0x15, 0x50, 0xF8, 0x42, 0x13, 0x13, 0x37, 0x12, 0x13, 0x12,
+	0x40, 0xF1, 0x15, 0x53, 0x16, 0x16, 0x16, 0x13, 0x13, 0x30, 0x00, 0x00, 0x00, 0xCC, 0x44, 0x44,
+	0x44, 0x4C, 0x36, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xEE, 0x44, 0x44, 0x28, 0x28, 0x10, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0xEE, 0x44, 0x54, 0x54, 0x54, 0x28, 0x00, 0x00, 0x00, 0xF6, 0x22,
+	0x22, 0x12, 0x14, 0x25, 0x24, 0x12, 0x12, 0x22, 0x20, 0x00, 0x00, 0x00, 0xEE, 0x44, 0x24, 0x28,
+	0x18, 0x10, 0x10, 0x78, 0x00, 0xF7, 0x52, 0x12, 0x15, 0x15, 0x15, 0x13, 0x12, 0x50, 0xB1, 0x51,
+	0x61, 0x61, 0x61, 0x51, 0x71, 0x61, 0x61, 0x71, 0xA1, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61,
+	0x61, 0x91, 0x71, 0x61, 0x61, 0x61, 0x71, 0x51, 0x61, 0x61, 0x51, 0xFF, 0x71, 0x21, 0x21, 0x12,
+};
+
+static const uint16_t Font12_RLE_Offsets[96] = {
+	0x0000, 0x0000, 0x0007, 0x800D, 0x0019, 0x0023, 0x002D, 0x0038,
+	0x003C, 0x0046, 0x0050, 0x0057, 0x005F, 0x0065, 0x0067, 0x006B,
+	0x8074, 0x0080, 0x0088, 0x0092, 0x809C, 0x00A8, 0x00B1, 0x00BC,
+	0x80C5, 0x00D1, 0x00DC, 0x00E1, 0x00E7, 0x00EF, 0x00F2, 0x00F9,
+	0x8101, 0x810D, 0x8119, 0x0125, 0x812F, 0x813B, 0x0147, 0x8152,
+	0x815E, 0x016A, 0x0172, 0x817D, 0x0189, 0x8193, 0x819F, 0x81AB,
+	0x01B7, 0x81C2, 0x81CE, 0x81DA, 0x01E6, 0x81EF, 0x81FB, 0x8207,
+	0x8213, 0x821F, 0x022B, 0x0235, 0x023F, 0x0248, 0x0252, 0x0258,
+	0x025C, 0x025E, 0x8268, 0x0274, 0x827D, 0x0289, 0x0291, 0x8299,
+	0x82A5, 0x02B1, 0x02B8, 0x82C1, 0x02CD, 0x82D5, 0x82E1, 0x02ED,
+	0x82F8, 0x8304, 0x0310, 0x0318, 0x0321, 0x832A, 0x8336, 0x8342,
+	0x034E, 0x8359, 0x0365, 0x036E, 0x0378, 0x0381, 0x038B, 0x0390,
+};
+
+sFONT Font12_RLE = {
+	NULL,
+	7, /* Width */
+	12, /* Height */
+	Font12_RLE_Data,
+	Font12_RLE_Offsets,
+};
+
+static const uint8_t Font16_RLE_Data[1288] = {
+	0xF0, 0x29, 0x29, 0x29, 0x29, 0x29, 0x29, 0x29, 0x2F, 0x52, 0xFA, 0x31, 0x34, 0x31, 0x35, 0x13,
+	0x16, 0x13, 0x16, 0x13, 0x10, 0xF0, 0x21, 0x26, 0x21, 0x26, 0x21, 0x26, 0x21, 0x24, 0x84, 0x21,
+	0x25, 0x84, 0x21, 0x26, 0x21, 0x26, 0x21, 0x26, 0x21, 0x20, 0x51, 0x86, 0x42, 0x32, 0x42, 0x32,
+	0x43, 0x94, 0x84, 0x93, 0x42, 0x32, 0x42, 0x32, 0x46, 0x81, 0xA1, 0xE2, 0x81, 0x21, 0x71, 0x21,
+	0x82, 0x32, 0x64, 0x54, 0x62, 0x32, 0x81, 0x21, 0x71, 0x21, 0x82, 0xFB, 0x46, 0x29, 0x29, 0x2A,
+	0x28, 0x31, 0x24, 0x21, 0x35, 0x22, 0x26, 0x31, 0x20, 0xFC, 0x38, 0x39, 0x1A, 0x1A, 0x10, 0xF2,
+	0x29, 0x28, 0x28, 0x38, 0x29, 0x29, 0x29, 0x29, 0x39, 0x2A, 0x29, 0x20, 0xE2, 0x92, 0xA2, 0xA2,
+	0x92, 0x92, 0x92, 0x92, 0x92, 0x82, 0x83, 0x82, 0xF1, 0x29, 0x26, 0x83, 0x85, 0x46, 0x65, 0x22,
+	0x20, 0xFF, 0x81, 0xA1, 0xA1, 0x77, 0x71, 0xA1, 0xA1, 0xFF, 0xFF, 0xFF, 0xE2, 0x91, 0x92, 0x91,
+	0xA1, 0xFF, 0xFF, 0x87, 0xFF, 0xFF, 0xFF, 0xD2, 0x92, 0x82, 0x92, 0x82, 0x92, 0x82, 0x92, 0x82,
+	0x82, 0x92, 0x82, 0x92, 0x82, 0x92, 0xF0, 0x37, 0x21, 0x25, 0x23, 0x24, 0x23, 0x24, 0x23, 0x24,
+	0x23, 0x24, 0x23, 0x24, 0x23, 0x25, 0x21, 0x27, 0x30, 0xF1, 0x26, 0x59, 0x29, 0x29, 0x29, 0x29,
+	0x29, 0x29, 0x26, 0x80, 0xF0, 0x46, 0x22, 0x24, 0x23, 0x24, 0x23, 0x28, 0x28, 0x28, 0x28, 0x28,
+	0x29, 0x70, 0xD6, 0x42, 0x42, 0x92, 0x82, 0x65, 0x93, 0x92, 0x92, 0x32, 0x42, 0x46, 0xF1, 0x38,
+	0x37, 0x47, 0x11, 0x26, 0x21, 0x26, 0x12, 0x25, 0x22, 0x25, 0x78, 0x27, 0x50, 0xE6, 0x52, 0x92,
+	0x92, 0x95, 0x61, 0x32, 0x92, 0x92, 0x41, 0x42, 0x55, 0xF1, 0x45, 0x38, 0x28, 0x29, 0x21, 0x35,
+	0x32, 0x24, 0x23, 0x24, 0x23, 0x25, 0x22, 0x26, 0x40, 0xC7, 0x41, 0x42, 0x92, 0x82, 0x92, 0x92,
+	0x92, 0x82, 0x92, 0x92, 0xE5, 0x52, 0x32, 0x42, 0x32, 0x42, 0x32, 0x55, 0x52, 0x32, 0x42, 0x32,
+	0x42, 0x32, 0x42, 0x32, 0x55, 0xE4, 0x62, 0x22, 0x52, 0x32, 0x42, 0x32, 0x42, 0x23, 0x53, 0x12,
+	0x92, 0x82, 0x83, 0x54, 0xFF, 0xF3, 0x29, 0x2F, 0xFC, 0x29, 0x20, 0xFF, 0xF5, 0x29, 0x2F, 0xFB,
+	0x29, 0x19, 0x1A, 0x10, 0xFF, 0x02, 0x72, 0x81, 0x82, 0x72, 0xB2, 0xB1, 0xB2, 0xB2, 0xFF, 0xFB,
+	0x9D, 0x90, 0xF8, 0x2B, 0x2B, 0x1B, 0x2B, 0x27, 0x28, 0x18, 0x27, 0x20, 0xFA, 0x55, 0x23, 0x24,
+	0x23, 0x29, 0x27, 0x37, 0x29, 0x2F, 0x52, 0xF0, 0x37, 0x13, 0x15, 0x14, 0x15, 0x14, 0x15, 0x12,
+	0x35, 0x11, 0x12, 0x15, 0x11, 0x12, 0x15, 0x12, 0x35, 0x1B, 0x13, 0x17, 0x30, 0xF9, 0x67, 0x47,
+	0x12, 0x16, 0x22, 0x25, 0x22, 0x25, 0x64, 0x24, 0x23, 0x24, 0x22, 0x42, 0x40, 0xF8, 0x75, 0x23,
+	0x24, 0x23, 0x24, 0x23, 0x24, 0x65, 0x23, 0x24, 0x23, 0x24, 0x23, 0x23, 0x70, 0xFA, 0x51, 0x13,
+	0x24, 0x22, 0x26, 0x12, 0x29, 0x29, 0x29, 0x26, 0x13, 0x24, 0x15, 0x50, 0xF8, 0x75, 0x23, 0x24,
+	0x24, 0x23, 0x24, 0x23, 0x24, 0x23, 0x24, 0x23, 0x24, 0x23, 0x23, 0x23, 0x70, 0xF8, 0x84, 0x24,
+	0x14, 0x24, 0x14, 0x22, 0x16, 0x56, 0x22, 0x16, 0x24, 0x14, 0x24, 0x13, 0x80, 0xF8, 0x93, 0x25,
+	0x13, 0x25, 0x13, 0x22, 0x16, 0x56, 0x22, 0x16, 0x29, 0x28, 0x50, 0xFA, 0x41, 0x14, 0x23, 0x23,
+	0x25, 0x13, 0x29, 0x29, 0x22, 0x52, 0x24, 0x24, 0x23, 0x25, 0x50, 0xF8, 0x41, 0x43, 0x23, 0x24,
+	0x23, 0x24, 0x23, 0x24, 0x74, 0x23, 0x24, 0x23, 0x24, 0x23, 0x23, 0x41, 0x40, 0xF9, 0x86, 0x29,
+	0x29, 0x29, 0x29, 0x29, 0x29, 0x26, 0x80, 0xFA, 0x77, 0x29, 0x29, 0x29, 0x24, 0x23, 0x24, 0x23,
+	0x24, 0x23, 0x25, 0x50, 0xF8, 0x41, 0x43, 0x23, 0x24, 0x22, 0x25, 0x21, 0x26, 0x47, 0x56, 0x22,
+	0x25, 0x23, 0x23, 0x42, 0x30, 0xF8, 0x67, 0x29, 0x29, 0x29, 0x29, 0x24, 0x14, 0x24, 0x14, 0x24,
+	0x12, 0x90, 0xF7, 0x35, 0x31, 0x25, 0x22, 0x33, 0x32, 0x41, 0x42, 0x21, 0x11, 0x11, 0x22, 0x21,
+	0x31, 0x22, 0x22, 0x12, 0x22, 0x25, 0x21, 0x51, 0x50, 0xF8, 0x32, 0x43, 0x23, 0x24, 0x32, 0x24,
+	0x41, 0x24, 0x21, 0x11, 0x24, 0x21, 0x44, 0x22, 0x34, 0x23, 0x23, 0x42, 0x20, 0xFA, 0x55, 0x23,
+	0x23, 0x25, 0x22, 0x25, 0x22, 0x25, 0x22, 0x25, 0x22, 0x25, 0x23, 0x23, 0x25, 0x50, 0xF8, 0x75,
+	0x23, 0x24, 0x23, 0x24, 0x23, 0x24, 0x23, 0x24, 0x65, 0x29, 0x28, 0x60, 0xFA, 0x55, 0x23, 0x23,
+	0x25, 0x22, 0x25, 0x22, 0x25, 0x22, 0x25, 0x22, 0x25, 0x23, 0x23, 0x25, 0x57, 0x22, 0x24, 0x60,
+	0xF8, 0x75, 0x23, 0x24, 0x23, 0x24, 0x23, 0x24, 0x56, 0x22, 0x25, 0x23, 0x24, 0x23, 0x23, 0x52,
+	0x30, 0xFA, 0x64, 0x23, 0x24, 0x23, 0x24, 0x39, 0x59, 0x34, 0x23, 0x24, 0x23, 0x24, 0x60, 0xF8,
+	0x83, 0x12, 0x22, 0x13, 0x12, 0x22, 0x13, 0x12, 0x22, 0x16, 0x29, 0x29, 0x29, 0x27, 0x60, 0xF8,
+	0x41, 0x43, 0x23, 0x24, 0x23, 0x24, 0x23, 0x24, 0x23, 0x24, 0x23, 0x24, 0x23, 0x24, 0x23, 0x25,
+	0x50, 0xF8, 0x41, 0x43, 0x23, 0x24, 0x23, 0x25, 0x21, 0x26, 0x21, 0x26, 0x21, 0x27, 0x11, 0x18,
+	0x38, 0x30, 0xF7, 0x51, 0x51, 0x25, 0x22, 0x22, 0x12, 0x22, 0x21, 0x31, 0x22, 0x21, 0x31, 0x23,
+	0x11, 0x11, 0x11, 0x14, 0x31, 0x34, 0x31, 0x34, 0x23, 0x20, 0xF8, 0x41, 0x43, 0x23, 0x25, 0x21,
+	0x27, 0x38, 0x38, 0x37, 0x21, 0x25, 0x23, 0x23, 0x41, 0x40, 0xF8, 0x42, 0x42, 0x24, 0x24, 0x22,
+	0x26, 0x48, 0x29, 0x29, 0x29, 0x27, 0x60, 0xF9, 0x74, 0x14, 0x24, 0x13, 0x28, 0x29, 0x19, 0x28,
+	0x23, 0x14, 0x24, 0x14, 0x70, 0xF1, 0x47, 0x29, 0x29, 0x29, 0x29, 0x29, 0x29, 0x29, 0x29, 0x29,
+	0x29, 0x40, 0x22, 0x92, 0xA2, 0x92, 0xA2, 0x92, 0xA2, 0xA2, 0x92, 0xA2, 0x92, 0xA2, 0x92, 0xE4,
+	0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x74, 0x51, 0x91, 0x11, 0x81, 0x11,
+	0x71, 0x31, 0x51, 0x51, 0x41, 0x51, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0, 0xB0, 0x41, 0xB1, 0xB1,
+	0xFF, 0xF2, 0x5A, 0x29, 0x25, 0x64, 0x23, 0x24, 0x22, 0x35, 0x31, 0x30, 0xC3, 0x92, 0x92, 0x92,
+	0x13, 0x53, 0x22, 0x42, 0x42, 0x32, 0x42, 0x32, 0x42, 0x33, 0x22, 0x33, 0x13, 0xFF, 0xF2, 0x41,
+	0x14, 0x23, 0x23, 0x25, 0x13, 0x29, 0x25, 0x14, 0x23, 0x25, 0x50, 0xF2, 0x39, 0x29, 0x25, 0x31,
+	0x24, 0x22, 0x33, 0x24, 0x23, 0x24, 0x23, 0x24, 0x24, 0x22, 0x35, 0x31, 0x30, 0xFF, 0xF2, 0x55,
+	0x23, 0x23, 0x25, 0x22, 0x92, 0x2A, 0x24, 0x24, 0x60, 0xF1, 0x64, 0x29, 0x27, 0x76, 0x29, 0x29,
+	0x29, 0x29, 0x27, 0x70, 0xFF, 0xF2, 0x31, 0x33, 0x22, 0x33, 0x24, 0x23, 0x24, 0x23, 0x24, 0x24,
+	0x22, 0x35, 0x31, 0x29, 0x29, 0x25, 0x50, 0xC3, 0x92, 0x92, 0x92, 0x13, 0x53, 0x22, 0x42, 0x32,
+	0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x34, 0x14, 0xF1, 0x29, 0x2F, 0x34, 0x92, 0x92, 0x92, 0x92,
+	0x92, 0x68, 0xF1, 0x29, 0x2F, 0x26, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x55, 0xC3,
+	0x92, 0x92, 0x92, 0x14, 0x42, 0x12, 0x64, 0x74, 0x72, 0x12, 0x62, 0x22, 0x43, 0x15, 0xE4, 0x92,
+	0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x68, 0xFF, 0xF0, 0x84, 0x21, 0x21, 0x23, 0x21, 0x21,
+	0x23, 0x21, 0x21, 0x23, 0x21, 0x21, 0x23, 0x21, 0x21, 0x22, 0x31, 0x21, 0x30, 0xFF, 0xF0, 0x31,
+	0x35, 0x32, 0x24, 0x23, 0x24, 0x23, 0x24, 0x23, 0x24, 0x23, 0x23, 0x41, 0x40, 0xFF, 0xF2, 0x55,
+	0x23, 0x23, 0x25, 0x22, 0x25, 0x22, 0x25, 0x23, 0x23, 0x25, 0x50, 0xFF, 0xF0, 0x31, 0x35, 0x32,
+	0x24, 0x24, 0x23, 0x24, 0x23, 0x24, 0x23, 0x32, 0x24, 0x21, 0x35, 0x29, 0x28, 0x50, 0xFF, 0xF2,
+	0x31, 0x33, 0x22, 0x33, 0x24, 0x23, 0x24, 0x23, 0x24, 0x24, 0x22, 0x35, 0x31, 0x29, 0x29, 0x27,
+	0x50, 0xFF, 0xF0, 0x41, 0x35, 0x32, 0x24, 0x29, 0x29, 0x29, 0x27, 0x70, 0xFF, 0xF2, 0x64, 0x23,
+	0x24, 0x48, 0x59, 0x34, 0x23, 0x24, 0x60, 0xE2, 0x92, 0x92, 0x77, 0x62, 0x92, 0x92, 0x92, 0x92,
+	0x31, 0x64, 0xFF, 0xF0, 0x32, 0x34, 0x23, 0x24, 0x23, 0x24, 0x23, 0x24, 0x23, 0x24, 0x22, 0x35,
+	0x31, 0x30, 0xFF, 0xF0, 0x41, 0x43, 0x23, 0x24, 0x23, 0x25, 0x21, 0x26, 0x21, 0x27, 0x38, 0x30,
+	0xFF, 0xE4, 0x34, 0x12, 0x52, 0x22, 0x21, 0x22, 0x22, 0x13, 0x12, 0x33, 0x13, 0x43, 0x13, 0x42,
+	0x32, 0xFF, 0xF0, 0x41, 0x44, 0x21, 0x27, 0x38, 0x38, 0x37, 0x21, 0x24, 0x41, 0x40, 0xFF, 0xF0,
+	0x42, 0x42, 0x24, 0x24, 0x22, 0x25, 0x22, 0x26, 0x11, 0x27, 0x48, 0x29, 0x28, 0x27, 0x50, 0xFF,
+	0xF1, 0x74, 0x14, 0x28, 0x27, 0x37, 0x28, 0x24, 0x14, 0x70, 0xF1, 0x28, 0x29, 0x29, 0x29, 0x29,
+	0x28, 0x2A, 0x29, 0x29, 0x29, 0x2A, 0x20, 0xF1, 0x29, 0x29, 0x29, 0x29, 0x29, 0x29, 0x29, 0x29,
+	0x29, 0x29, 0x29, 0x20, 0xF0, 0x2A, 0x29, 0x29, 0x29, 0x29, 0x2A, 0x28, 0x29, 0x29, 0x29, 0x28,
+	0x20, 0xFF, 0xFD, 0x28, 0x12, 0x12, 0x18, 0x20,
+};
+
+static const uint16_t Font16_RLE_Offsets[96] = {
+	0x0000, 0x0000, 0x000A, 0x0015, 0x002A, 0x003B, 0x004B, 0x0059,
+	0x005F, 0x006C, 0x0078, 0x0081, 0x0089, 0x0091, 0x0094, 0x0099,
+	0x00A6, 0x00B9, 0x00C4, 0x00D2, 0x00DE, 0x00ED, 0x00F9, 0x0109,
+	0x0114, 0x0125, 0x0134, 0x013B, 0x0144, 0x014E, 0x0152, 0x015C,
+	0x0167, 0x017D, 0x018D, 0x019D, 0x01AC, 0x01BD, 0x01CD, 0x01DB,
+	0x01EB, 0x01FD, 0x0207, 0x0214, 0x0225, 0x0232, 0x0249, 0x025D,
+	0x026E, 0x027C, 0x0290, 0x02A1, 0x02AF, 0x02BF, 0x02D1, 0x02E2,
+	0x02FA, 0x030A, 0x0317, 0x0325, 0x0332, 0x033F, 0x034B, 0x0356,
+	0x035D, 0x0360, 0x036C, 0x037D, 0x038B, 0x039D, 0x03A9, 0x03B4,
+	0x03C7, 0x03D8, 0x03E2, 0x03EF, 0x03FE, 0x0408, 0x041D, 0x042D,
+	0x043B, 0x044E, 0x0461, 0x046C, 0x0477, 0x0482, 0x0492, 0x04A0,
+	0x04B1, 0x04BE, 0x04CF, 0x04DA, 0x04E7, 0x04F4, 0x0501, 0x0508,
+};
+
+sFONT Font16_RLE = {
+	NULL,
+	11, /* Width */
+	16, /* Height */
+	Font16_RLE_Data,
+	Font16_RLE_Offsets,
+};
+
+static const uint8_t Font20_RLE_Data[1638] = {
+	0xF4, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3B, 0x3C, 0x1D, 0x1F, 0xFA, 0x3B, 0x30, 0xFF, 0x13, 0x23,
+	0x63, 0x23, 0x63, 0x23, 0x71, 0x41, 0x81, 0x41, 0x81, 0x41, 0x42, 0x22, 0x82, 0x22, 0x82, 0x22,
+	0x82, 0x22, 0x82, 0x22, 0x6A, 0x4A, 0x62, 0x22, 0x82, 0x22, 0x6A, 0x4A, 0x62, 0x22, 0x82, 0x22,
+	0x82, 0x22, 0x82, 0x22, 0x82, 0x22, 0x62, 0xC2, 0xB6, 0x77, 0x62, 0x42, 0x62, 0xC5, 0xA6, 0xC3,
+	0x62, 0x42, 0x62, 0x42, 0x67, 0x76, 0xB2, 0xC2, 0xC2, 0xF2, 0x3A, 0x13, 0x19, 0x13, 0x19, 0x13,
+	0x1A, 0x33, 0x2A, 0x47, 0x57, 0x4A, 0x23, 0x3A, 0x13, 0x19, 0x13, 0x19, 0x13, 0x1A, 0x30, 0xFF,
+	0xF3, 0x57, 0x77, 0x2C, 0x2D, 0x2B, 0x42, 0x25, 0x95, 0x22, 0x46, 0x23, 0x27, 0x97, 0x41, 0x20,
+	0xFF, 0x43, 0xB3, 0xB3, 0xC1, 0xD1, 0xD1, 0xF7, 0x2C, 0x2B, 0x2C, 0x2C, 0x2B, 0x2C, 0x2C, 0x2C,
+	0x2C, 0x2C, 0x2D, 0x2C, 0x2C, 0x2D, 0x2C, 0x20, 0xF3, 0x2C, 0x2D, 0x2C, 0x2C, 0x2D, 0x2C, 0x2C,
+	0x2C, 0x2C, 0x2C, 0x2B, 0x2C, 0x2C, 0x2B, 0x2C, 0x20, 0xF5, 0x2C, 0x2C, 0x29, 0x21, 0x21, 0x26,
+	0x88, 0x4A, 0x49, 0x68, 0x22, 0x20, 0xFF, 0xF3, 0x2C, 0x2C, 0x2C, 0x28, 0xA4, 0xA8, 0x2C, 0x2C,
+	0x2C, 0x20, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xA3, 0xB2, 0xC2, 0xB2, 0xC2, 0xC1, 0xFF, 0xFF, 0xFF,
+	0xA9, 0x59, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xA3, 0xB3, 0xB3, 0x92, 0xC2, 0xB2, 0xC2, 0xC2, 0xB2,
+	0xC2, 0xB2, 0xC2, 0xB2, 0xC2, 0xB2, 0xC2, 0xC2, 0xB2, 0xC2, 0xF3, 0x58, 0x77, 0x23, 0x26, 0x25,
+	0x25, 0x25, 0x25, 0x25, 0x25, 0x25, 0x25, 0x25, 0x25, 0x25, 0x25, 0x25, 0x26, 0x23, 0x27, 0x78,
+	0x50, 0xF5, 0x29, 0x59, 0x5C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x29, 0x86, 0x80, 0xF3,
+	0x58, 0x76, 0x33, 0x35, 0x25, 0x2C, 0x2B, 0x2B, 0x2B, 0x2B, 0x2B, 0x2B, 0x2B, 0x95, 0x90, 0xF3,
+	0x57, 0x86, 0x24, 0x3C, 0x2B, 0x38, 0x59, 0x5C, 0x3C, 0x2C, 0x24, 0x25, 0x34, 0x96, 0x70, 0xF6,
+	0x3A, 0x4A, 0x49, 0x21, 0x28, 0x22, 0x28, 0x22, 0x27, 0x23, 0x26, 0x24, 0x26, 0x95, 0x9B, 0x2A,
+	0x59, 0x50, 0xF2, 0x77, 0x77, 0x2C, 0x2C, 0x68, 0x77, 0x23, 0x3C, 0x2C, 0x2C, 0x25, 0x24, 0x35,
+	0x87, 0x60, 0xF5, 0x57, 0x76, 0x4A, 0x2B, 0x3B, 0x21, 0x47, 0x86, 0x33, 0x35, 0x25, 0x25, 0x25,
+	0x26, 0x23, 0x36, 0x79, 0x40, 0xF1, 0x95, 0x95, 0x25, 0x2C, 0x2B, 0x2C, 0x2C, 0x2B, 0x2C, 0x2C,
+	0x2B, 0x2C, 0x2C, 0x20, 0xF3, 0x58, 0x76, 0x33, 0x35, 0x25, 0x25, 0x33, 0x36, 0x77, 0x76, 0x33,
+	0x35, 0x25, 0x25, 0x25, 0x25, 0x33, 0x36, 0x78, 0x50, 0xF3, 0x49, 0x76, 0x33, 0x26, 0x25, 0x25,
+	0x25, 0x25, 0x33, 0x36, 0x87, 0x41, 0x2B, 0x3B, 0x2A, 0x46, 0x77, 0x50, 0xFF, 0xFF, 0xF1, 0x3B,
+	0x3B, 0x3F, 0xFF, 0x83, 0xB3, 0xB3, 0xFF, 0xFF, 0xF2, 0x3B, 0x3B, 0x3F, 0xFF, 0x73, 0xB2, 0xB2,
+	0xC2, 0xC1, 0xFF, 0xF7, 0x2A, 0x48, 0x49, 0x39, 0x39, 0x4C, 0x3D, 0x3C, 0x4C, 0x4C, 0x20, 0xFF,
+	0xFF, 0xBB, 0x3B, 0xFF, 0x1B, 0x3B, 0xFF, 0xE2, 0xC4, 0xC4, 0xC3, 0xD3, 0xC4, 0x93, 0x93, 0x94,
+	0x84, 0xA2, 0xFF, 0x25, 0x87, 0x72, 0x42, 0x62, 0x42, 0xC2, 0xA3, 0xA3, 0xB2, 0xFF, 0x93, 0xB3,
+	0xF5, 0x39, 0x22, 0x19, 0x14, 0x17, 0x15, 0x17, 0x15, 0x17, 0x13, 0x37, 0x12, 0x12, 0x17, 0x12,
+	0x12, 0x17, 0x12, 0x12, 0x17, 0x13, 0x37, 0x1E, 0x1D, 0x14, 0x19, 0x40, 0xFF, 0x16, 0x86, 0xB3,
+	0xA2, 0x12, 0x92, 0x12, 0x82, 0x22, 0x82, 0x32, 0x68, 0x68, 0x52, 0x62, 0x34, 0x44, 0x24, 0x44,
+	0xFF, 0x07, 0x78, 0x72, 0x42, 0x62, 0x42, 0x62, 0x33, 0x67, 0x78, 0x62, 0x43, 0x52, 0x52, 0x52,
+	0x52, 0x4A, 0x49, 0xFF, 0x34, 0x12, 0x68, 0x53, 0x33, 0x43, 0x52, 0x42, 0xC2, 0xC2, 0xC2, 0xC3,
+	0x52, 0x53, 0x33, 0x67, 0x85, 0xFE, 0x86, 0x96, 0x24, 0x35, 0x25, 0x34, 0x26, 0x24, 0x26, 0x24,
+	0x26, 0x24, 0x26, 0x24, 0x25, 0x34, 0x24, 0x34, 0x95, 0x80, 0xFF, 0x0A, 0x4A, 0x52, 0x52, 0x52,
+	0x52, 0x52, 0x22, 0x86, 0x86, 0x82, 0x22, 0x82, 0x52, 0x52, 0x52, 0x4A, 0x4A, 0xFF, 0x0A, 0x4A,
+	0x52, 0x52, 0x52, 0x52, 0x52, 0x22, 0x86, 0x86, 0x82, 0x22, 0x82, 0xC2, 0xB6, 0x86, 0xFF, 0x34,
+	0x12, 0x59, 0x52, 0x43, 0x42, 0x62, 0x42, 0xC2, 0xC2, 0x36, 0x32, 0x36, 0x32, 0x62, 0x52, 0x52,
+	0x59, 0x75, 0xFF, 0x04, 0x24, 0x44, 0x24, 0x52, 0x42, 0x62, 0x42, 0x62, 0x42, 0x68, 0x68, 0x62,
+	0x42, 0x62, 0x42, 0x62, 0x42, 0x54, 0x24, 0x44, 0x24, 0xFF, 0x18, 0x68, 0x92, 0xC2, 0xC2, 0xC2,
+	0xC2, 0xC2, 0xC2, 0xC2, 0x98, 0x68, 0xFF, 0x47, 0x77, 0xA2, 0xC2, 0xC2, 0xC2, 0x52, 0x52, 0x52,
+	0x52, 0x52, 0x52, 0x52, 0x43, 0x58, 0x85, 0xFF, 0x05, 0x15, 0x35, 0x15, 0x42, 0x33, 0x62, 0x22,
+	0x82, 0x12, 0x95, 0x93, 0x12, 0x82, 0x32, 0x72, 0x32, 0x72, 0x42, 0x55, 0x24, 0x35, 0x33, 0xFF,
+	0x06, 0x86, 0xA2, 0xC2, 0xC2, 0xC2, 0xC2, 0xC2, 0x42, 0x62, 0x42, 0x62, 0x42, 0x4A, 0x4A, 0xFE,
+	0x44, 0x42, 0x44, 0x43, 0x34, 0x34, 0x42, 0x44, 0x21, 0x12, 0x11, 0x24, 0x21, 0x41, 0x24, 0x21,
+	0x41, 0x24, 0x22, 0x22, 0x24, 0x22, 0x22, 0x24, 0x26, 0x23, 0x52, 0x52, 0x52, 0x50, 0xFF, 0x03,
+	0x25, 0x44, 0x15, 0x53, 0x32, 0x64, 0x22, 0x64, 0x22, 0x62, 0x12, 0x12, 0x62, 0x12, 0x12, 0x62,
+	0x24, 0x62, 0x24, 0x62, 0x33, 0x55, 0x13, 0x55, 0x22, 0xFF, 0x34, 0x96, 0x73, 0x23, 0x53, 0x43,
+	0x42, 0x62, 0x42, 0x62, 0x42, 0x62, 0x42, 0x62, 0x43, 0x43, 0x53, 0x23, 0x76, 0x94, 0xFF, 0x08,
+	0x69, 0x62, 0x43, 0x52, 0x52, 0x52, 0x52, 0x52, 0x43, 0x58, 0x67, 0x72, 0xC2, 0xB6, 0x86, 0xFF,
+	0x34, 0x96, 0x73, 0x23, 0x53, 0x43, 0x42, 0x62, 0x42, 0x62, 0x42, 0x62, 0x42, 0x62, 0x43, 0x43,
+	0x53, 0x23, 0x76, 0x94, 0xA4, 0x12, 0x68, 0x62, 0x23, 0xFF, 0x08, 0x69, 0x62, 0x43, 0x52, 0x52,
+	0x52, 0x43, 0x58, 0x67, 0x72, 0x33, 0x62, 0x42, 0x62, 0x43, 0x45, 0x33, 0x35, 0x42, 0xFF, 0x25,
+	0x12, 0x59, 0x43, 0x43, 0x42, 0x62, 0x43, 0xC6, 0xA6, 0xC3, 0x42, 0x62, 0x43, 0x43, 0x49, 0x52,
+	0x15, 0xFF, 0x0A, 0x4A, 0x42, 0x22, 0x22, 0x42, 0x22, 0x22, 0x42, 0x22, 0x22, 0x82, 0xC2, 0xC2,
+	0xC2, 0xC2, 0xA6, 0x86, 0xFF, 0x04, 0x24, 0x44, 0x24, 0x52, 0x42, 0x62, 0x42, 0x62, 0x42, 0x62,
+	0x42, 0x62, 0x42, 0x62, 0x42, 0x62, 0x42, 0x63, 0x23, 0x76, 0x94, 0xFE, 0x43, 0x43, 0x43, 0x44,
+	0x25, 0x25, 0x25, 0x26, 0x23, 0x27, 0x23, 0x28, 0x21, 0x29, 0x21, 0x29, 0x21, 0x2A, 0x3B, 0x3B,
+	0x30, 0xFE, 0x53, 0x51, 0x53, 0x52, 0x27, 0x23, 0x22, 0x32, 0x23, 0x22, 0x32, 0x23, 0x22, 0x32,
+	0x23, 0x21, 0x21, 0x21, 0x24, 0x11, 0x21, 0x21, 0x15, 0x33, 0x35, 0x33, 0x35, 0x33, 0x35, 0x25,
+	0x20, 0xFE, 0x43, 0x43, 0x43, 0x44, 0x25, 0x26, 0x23, 0x28, 0x21, 0x2A, 0x3B, 0x3A, 0x21, 0x28,
+	0x23, 0x26, 0x25, 0x24, 0x43, 0x43, 0x43, 0x40, 0xFF, 0x04, 0x24, 0x44, 0x24, 0x52, 0x42, 0x72,
+	0x22, 0x94, 0xA4, 0xB2, 0xC2, 0xC2, 0xC2, 0xA6, 0x86, 0xFF, 0x18, 0x68, 0x62, 0x42, 0x62, 0x32,
+	0xB2, 0xB2, 0xC2, 0xB2, 0xB2, 0x32, 0x62, 0x42, 0x68, 0x68, 0xF5, 0x4A, 0x4A, 0x2C, 0x2C, 0x2C,
+	0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x4A, 0x40, 0x32, 0xC2, 0xD2, 0xC2, 0xC2,
+	0xD2, 0xC2, 0xD2, 0xC2, 0xD2, 0xC2, 0xD2, 0xC2, 0xC2, 0xD2, 0xC2, 0xF3, 0x4A, 0x4C, 0x2C, 0x2C,
+	0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2A, 0x4A, 0x40, 0xF5, 0x1C, 0x3A, 0x21,
+	0x28, 0x23, 0x26, 0x25, 0x25, 0x17, 0x10, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xCF,
+	0xD0, 0xF4, 0x1E, 0x2E, 0x10, 0xFF, 0xFF, 0xE6, 0x78, 0xC2, 0x77, 0x68, 0x53, 0x42, 0x52, 0x43,
+	0x5A, 0x55, 0x13, 0xF0, 0x3B, 0x3C, 0x2C, 0x2C, 0x21, 0x47, 0x95, 0x34, 0x25, 0x26, 0x24, 0x26,
+	0x24, 0x26, 0x24, 0x34, 0x24, 0xA4, 0x31, 0x40, 0xFF, 0xFF, 0xF0, 0x41, 0x25, 0x95, 0x25, 0x24,
+	0x26, 0x24, 0x2C, 0x2C, 0x35, 0x25, 0x96, 0x60, 0xF8, 0x3B, 0x3C, 0x2C, 0x27, 0x41, 0x25, 0x95,
+	0x24, 0x34, 0x26, 0x24, 0x26, 0x24, 0x26, 0x24, 0x34, 0x35, 0xA6, 0x41, 0x30, 0xFF, 0xFF, 0xF0,
+	0x48, 0x86, 0x24, 0x25, 0xA4, 0xA4, 0x2D, 0x25, 0x25, 0x97, 0x50, 0xF5, 0x67, 0x77, 0x2C, 0x2A,
+	0x86, 0x88, 0x2C, 0x2C, 0x2C, 0x2C, 0x2A, 0x86, 0x80, 0xFF, 0xFF, 0xF0, 0x41, 0x34, 0xA4, 0x24,
+	0x34, 0x26, 0x24, 0x26, 0x24, 0x26, 0x25, 0x24, 0x35, 0x97, 0x41, 0x2C, 0x2B, 0x36, 0x77, 0x60,
+	0xF1, 0x3B, 0x3C, 0x2C, 0x2C, 0x21, 0x47, 0x86, 0x33, 0x26, 0x24, 0x26, 0x24, 0x26, 0x24, 0x26,
+	0x24, 0x25, 0x42, 0x44, 0x42, 0x40, 0xF5, 0x2C, 0x2F, 0xF7, 0x59, 0x5C, 0x2C, 0x2C, 0x2C, 0x2C,
+	0x29, 0x86, 0x80, 0xF5, 0x2C, 0x2F, 0xF7, 0x77, 0x7C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C,
+	0x2B, 0x36, 0x77, 0x60, 0xF1, 0x3B, 0x3C, 0x2C, 0x2C, 0x21, 0x56, 0x21, 0x56, 0x21, 0x29, 0x4A,
+	0x4A, 0x21, 0x29, 0x22, 0x27, 0x32, 0x54, 0x32, 0x50, 0xF2, 0x59, 0x5C, 0x2C, 0x2C, 0x2C, 0x2C,
+	0x2C, 0x2C, 0x2C, 0x2C, 0x29, 0x86, 0x80, 0xFF, 0xFF, 0xB6, 0x13, 0x4B, 0x42, 0x22, 0x22, 0x42,
+	0x22, 0x22, 0x42, 0x22, 0x22, 0x42, 0x22, 0x22, 0x42, 0x22, 0x22, 0x34, 0x13, 0x13, 0x24, 0x13,
+	0x13, 0xFF, 0xFF, 0xC3, 0x14, 0x69, 0x63, 0x32, 0x62, 0x42, 0x62, 0x42, 0x62, 0x42, 0x62, 0x42,
+	0x54, 0x24, 0x44, 0x24, 0xFF, 0xFF, 0xF0, 0x48, 0x86, 0x24, 0x25, 0x26, 0x24, 0x26, 0x24, 0x26,
+	0x25, 0x24, 0x26, 0x88, 0x40, 0xFF, 0xFF, 0xB3, 0x14, 0x6A, 0x53, 0x42, 0x52, 0x62, 0x42, 0x62,
+	0x42, 0x62, 0x43, 0x42, 0x59, 0x52, 0x14, 0x72, 0xC2, 0xB5, 0x95, 0xFF, 0xFF, 0xF0, 0x41, 0x34,
+	0xA4, 0x24, 0x34, 0x26, 0x24, 0x26, 0x24, 0x26, 0x25, 0x24, 0x35, 0x97, 0x41, 0x2C, 0x2C, 0x2A,
+	0x59, 0x50, 0xFF, 0xFF, 0xC4, 0x23, 0x54, 0x15, 0x64, 0x22, 0x63, 0xB2, 0xC2, 0xC2, 0xA8, 0x68,
+	0xFF, 0xFF, 0xF0, 0x66, 0x86, 0x24, 0x26, 0x4B, 0x6B, 0x46, 0x24, 0x26, 0x86, 0x60, 0xFF, 0x22,
+	0xC2, 0xC2, 0xA9, 0x59, 0x72, 0xC2, 0xC2, 0xC2, 0xC2, 0x42, 0x68, 0x75, 0xFF, 0xFF, 0xC3, 0x33,
+	0x53, 0x33, 0x62, 0x42, 0x62, 0x42, 0x62, 0x42, 0x62, 0x42, 0x62, 0x33, 0x69, 0x64, 0x13, 0xFF,
+	0xFF, 0xB4, 0x34, 0x34, 0x34, 0x42, 0x52, 0x62, 0x32, 0x72, 0x32, 0x82, 0x12, 0x92, 0x12, 0xA3,
+	0xB3, 0xFF, 0xFF, 0xB4, 0x34, 0x34, 0x34, 0x42, 0x21, 0x22, 0x52, 0x21, 0x22, 0x52, 0x16, 0x63,
+	0x13, 0x73, 0x13, 0x72, 0x32, 0x72, 0x32, 0xFF, 0xFF, 0xC4, 0x24, 0x44, 0x24, 0x62, 0x22, 0x94,
+	0xB2, 0xB4, 0x92, 0x22, 0x64, 0x24, 0x44, 0x24, 0xFF, 0xFF, 0xB4, 0x34, 0x34, 0x34, 0x42, 0x52,
+	0x62, 0x32, 0x72, 0x32, 0x82, 0x12, 0x95, 0xA3, 0xB2, 0xC2, 0xB2, 0x97, 0x77, 0xFF, 0xFF, 0xD8,
+	0x68, 0x62, 0x32, 0xB2, 0xB2, 0xB2, 0xB2, 0x32, 0x68, 0x68, 0xF6, 0x3A, 0x4A, 0x2C, 0x2C, 0x2C,
+	0x2C, 0x2B, 0x3A, 0x3C, 0x3C, 0x2C, 0x2C, 0x2C, 0x2C, 0x4B, 0x30, 0xF5, 0x2C, 0x2C, 0x2C, 0x2C,
+	0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x2C, 0x20, 0xF2, 0x3B, 0x4C, 0x2C,
+	0x2C, 0x2C, 0x2C, 0x2C, 0x3C, 0x3A, 0x3B, 0x2C, 0x2C, 0x2C, 0x2A, 0x4A, 0x30, 0xFF, 0xFF, 0xFD,
+	0x39, 0x62, 0x24, 0x22, 0x69, 0x40,
+};
+
+static const uint16_t Font20_RLE_Offsets[96] = {
+	0x0000, 0x0000, 0x000D, 0x001A, 0x0036, 0x0049, 0x005F, 0x0070,
+	0x0077, 0x0088, 0x0099, 0x00A6, 0x00B2, 0x00BD, 0x00C2, 0x00CA,
+	0x00DA, 0x00F1, 0x00FF, 0x010F, 0x011F, 0x0132, 0x0142, 0x0155,
+	0x0164, 0x0179, 0x018C, 0x0196, 0x01A2, 0x01AF, 0x01B6, 0x01C2,
+	0x01D0, 0x01EC, 0x0200, 0x0213, 0x0225, 0x023A, 0x024D, 0x025E,
+	0x0272, 0x0289, 0x0296, 0x02A7, 0x02BF, 0x02CF, 0x02EE, 0x0309,
+	0x031E, 0x032F, 0x0349, 0x035E, 0x0371, 0x0384, 0x039B, 0x03B1,
+	0x03D1, 0x03E8, 0x03F9, 0x040A, 0x041B, 0x042B, 0x043C, 0x0447,
+	0x0451, 0x0455, 0x0463, 0x0478, 0x0488, 0x049D, 0x04AB, 0x04B9,
+	0x04D0, 0x04E6, 0x04F3, 0x0504, 0x0519, 0x0527, 0x0541, 0x0554,
+	0x0565, 0x057B, 0x0592, 0x05A0, 0x05AE, 0x05BC, 0x05CF, 0x05E1,
+	0x05F7, 0x0608, 0x061D, 0x062A, 0x063B, 0x064C, 0x065D, 0x0666,
+};
+
+sFONT Font20_RLE = {
+	NULL,
+	14, /* Width */
+	20, /* Height */
+	Font20_RLE_Data,
+	Font20_RLE_Offsets,
+};
+
+static const uint8_t Font24_RLE_Data[2165] = {
+	0xFF, 0xA3, 0xE3, 0xE3, 0xE3, 0xE3, 0xE3, 0xE3, 0xE3, 0xE3, 0xF0, 0x1F, 0x11, 0xFF, 0xF4, 0x3E,
+	0x30, 0xFF, 0xFA, 0x32, 0x39, 0x32, 0x39, 0x32, 0x3A, 0x14, 0x1B, 0x14, 0x1B, 0x14, 0x1B, 0x14,
+	0x10, 0xFF, 0x92, 0x22, 0xB2, 0x22, 0xB2, 0x22, 0xB2, 0x22, 0xB2, 0x22, 0x8B, 0x6B, 0x92, 0x22,
+	0xA2, 0x22, 0x9B, 0x6B, 0x82, 0x22, 0xB2, 0x22, 0xB2, 0x22, 0xB2, 0x22, 0xB2, 0x22, 0xF9, 0x2F,
+	0x02, 0xD4, 0x12, 0x98, 0x82, 0x43, 0x82, 0x43, 0x83, 0xF0, 0x5D, 0x6E, 0x48, 0x25, 0x28, 0x34,
+	0x28, 0x33, 0x38, 0x89, 0x21, 0x4E, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xFF, 0x94, 0xC6, 0xA3, 0x23,
+	0x92, 0x42, 0x92, 0x42, 0x93, 0x23, 0xA9, 0x96, 0x99, 0xA3, 0x23, 0x92, 0x42, 0x92, 0x42, 0x93,
+	0x23, 0xA6, 0xC4, 0xFF, 0xFF, 0xE6, 0xA7, 0x92, 0x32, 0xA2, 0xF0, 0x2F, 0x12, 0xF0, 0x3D, 0x52,
+	0x36, 0x31, 0x76, 0x23, 0x48, 0x24, 0x39, 0xA8, 0x51, 0x30, 0xFF, 0xFC, 0x3E, 0x3E, 0x3F, 0x01,
+	0xF1, 0x1F, 0x11, 0xF1, 0x10, 0xFF, 0xF0, 0x2E, 0x3D, 0x3D, 0x4D, 0x3E, 0x3D, 0x3E, 0x3E, 0x3E,
+	0x3E, 0x3E, 0x3F, 0x03, 0xE3, 0xF0, 0x3E, 0x3F, 0x03, 0xF0, 0x20, 0xFF, 0x72, 0xF0, 0x3F, 0x03,
+	0xE3, 0xF0, 0x3E, 0x3F, 0x03, 0xE3, 0xE3, 0xE3, 0xE3, 0xE3, 0xD3, 0xE3, 0xD4, 0xD3, 0xD3, 0xE2,
+	0xFF, 0xB2, 0xF0, 0x2F, 0x02, 0xB3, 0x12, 0x13, 0x7A, 0x96, 0xC4, 0xD4, 0xC2, 0x22, 0xB2, 0x22,
+	0xFF, 0xFF, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2A, 0xC5, 0xCA, 0x2F, 0x02, 0xF0, 0x2F,
+	0x02, 0xF0, 0x20, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x63, 0xE2, 0xE3, 0xE2, 0xF0,
+	0x2E, 0x2F, 0x02, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x6A, 0x7A, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0x44, 0xD4, 0xD4, 0xB2, 0xF0, 0x2E, 0x3E, 0x2E, 0x3E, 0x2F, 0x02, 0xE2, 0xF0, 0x2E,
+	0x2F, 0x02, 0xE2, 0xF0, 0x2E, 0x2F, 0x02, 0xE3, 0xE2, 0xE3, 0xE2, 0xF0, 0x20, 0xFF, 0xA4, 0xC6,
+	0xA2, 0x42, 0x92, 0x42, 0x82, 0x62, 0x72, 0x62, 0x72, 0x62, 0x72, 0x62, 0x72, 0x62, 0x72, 0x62,
+	0x72, 0x62, 0x82, 0x42, 0x92, 0x42, 0xA6, 0xC4, 0xFF, 0xC1, 0xD4, 0xB6, 0xB3, 0x12, 0xF0, 0x2F,
+	0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2B, 0xA7, 0xA0, 0xFF, 0x95,
+	0xA9, 0x73, 0x52, 0x72, 0x72, 0x62, 0x72, 0xF0, 0x2E, 0x2E, 0x2D, 0x3D, 0x3D, 0x2E, 0x2E, 0x2E,
+	0xB6, 0xB0, 0xFF, 0xA4, 0xB7, 0xA2, 0x33, 0xF0, 0x2F, 0x02, 0xE2, 0xC4, 0xD5, 0xF0, 0x3F, 0x12,
+	0xF0, 0x2F, 0x02, 0x72, 0x53, 0x79, 0x96, 0xFF, 0xC3, 0xD4, 0xD4, 0xC2, 0x12, 0xB2, 0x22, 0xB2,
+	0x22, 0xA2, 0x32, 0xA2, 0x32, 0x92, 0x42, 0x82, 0x52, 0x8B, 0x6B, 0xD2, 0xC7, 0xA7, 0xFF, 0x79,
+	0x89, 0x82, 0xF0, 0x2F, 0x02, 0xF0, 0x21, 0x4A, 0x98, 0x34, 0x2F, 0x12, 0xF0, 0x2F, 0x02, 0xF0,
+	0x26, 0x26, 0x27, 0xA9, 0x60, 0xFF, 0xC5, 0xA7, 0x93, 0xD3, 0xE2, 0xE2, 0xF0, 0x21, 0x4A, 0x98,
+	0x34, 0x28, 0x26, 0x27, 0x26, 0x27, 0x26, 0x28, 0x24, 0x38, 0x8B, 0x50, 0xFF, 0x7A, 0x7A, 0x72,
+	0x62, 0x72, 0x53, 0xE2, 0xF0, 0x2E, 0x3E, 0x2F, 0x02, 0xE3, 0xE2, 0xF0, 0x2E, 0x3E, 0x2F, 0x02,
+	0xFF, 0x96, 0xA8, 0x83, 0x43, 0x72, 0x62, 0x72, 0x62, 0x82, 0x42, 0xA6, 0xB6, 0xA2, 0x42, 0x82,
+	0x62, 0x72, 0x62, 0x72, 0x62, 0x73, 0x43, 0x88, 0xA6, 0xFF, 0x95, 0xB8, 0x83, 0x42, 0x82, 0x62,
+	0x72, 0x62, 0x72, 0x62, 0x82, 0x43, 0x89, 0xA4, 0x12, 0xF0, 0x2E, 0x2E, 0x3D, 0x39, 0x7A, 0x50,
+	0xFF, 0xFF, 0xFF, 0xF3, 0x4D, 0x4D, 0x4F, 0xFF, 0xFF, 0xF8, 0x4D, 0x4D, 0x40, 0xFF, 0xFF, 0xFF,
+	0xF5, 0x4D, 0x4D, 0x4F, 0xFF, 0xFF, 0x63, 0xD3, 0xE2, 0xF0, 0x2E, 0x2F, 0x01, 0xFF, 0xFF, 0xF4,
+	0x3D, 0x4B, 0x4B, 0x4B, 0x4B, 0x4B, 0x4F, 0x04, 0xF0, 0x4F, 0x04, 0xF0, 0x4F, 0x04, 0xE3, 0xFF,
+	0xFF, 0xFF, 0xFF, 0x0D, 0x4D, 0xFF, 0x8D, 0x4D, 0xFF, 0xFF, 0x93, 0xE4, 0xF0, 0x4F, 0x04, 0xF0,
+	0x4F, 0x04, 0xF0, 0x4B, 0x4B, 0x4B, 0x4B, 0x4B, 0x4D, 0x30, 0xFF, 0xFB, 0x5B, 0x79, 0x24, 0x38,
+	0x25, 0x28, 0x25, 0x2E, 0x3D, 0x3C, 0x4D, 0x3E, 0x2F, 0xFF, 0x33, 0xE3, 0xFF, 0xA5, 0xB7, 0x93,
+	0x33, 0x82, 0x52, 0x72, 0x44, 0x72, 0x35, 0x72, 0x23, 0x12, 0x72, 0x22, 0x22, 0x72, 0x22, 0x22,
+	0x72, 0x22, 0x22, 0x72, 0x35, 0x72, 0x44, 0x72, 0xF1, 0x2F, 0x03, 0x42, 0x98, 0xA5, 0xFF, 0xF9,
+	0x6B, 0x7E, 0x3D, 0x21, 0x2C, 0x21, 0x2B, 0x23, 0x2A, 0x23, 0x29, 0x24, 0x29, 0x97, 0xA7, 0x27,
+	0x25, 0x28, 0x23, 0x63, 0x71, 0x63, 0x70, 0xFF, 0xF7, 0xA7, 0xB8, 0x25, 0x37, 0x26, 0x27, 0x26,
+	0x27, 0x25, 0x37, 0x98, 0xA7, 0x26, 0x36, 0x27, 0x26, 0x27, 0x26, 0x27, 0x24, 0xC5, 0xB0, 0xFF,
+	0xFC, 0x51, 0x27, 0xA6, 0x35, 0x36, 0x27, 0x25, 0x28, 0x25, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0,
+	0x2F, 0x12, 0x72, 0x63, 0x53, 0x79, 0xA6, 0xFF, 0xF7, 0x98, 0xB8, 0x25, 0x37, 0x26, 0x27, 0x27,
+	0x26, 0x27, 0x26, 0x27, 0x26, 0x27, 0x26, 0x27, 0x26, 0x27, 0x26, 0x26, 0x27, 0x25, 0x35, 0xB6,
+	0xA0, 0xFF, 0xF7, 0xC5, 0xC7, 0x26, 0x27, 0x26, 0x27, 0x22, 0x22, 0x27, 0x22, 0x2B, 0x6B, 0x6B,
+	0x22, 0x2B, 0x22, 0x22, 0x27, 0x26, 0x27, 0x26, 0x25, 0xC5, 0xC0, 0xFF, 0xF8, 0xC5, 0xC7, 0x26,
+	0x27, 0x26, 0x27, 0x22, 0x22, 0x27, 0x22, 0x2B, 0x6B, 0x6B, 0x22, 0x2B, 0x22, 0x2B, 0x2F, 0x02,
+	0xD8, 0x98, 0xFF, 0xFC, 0x51, 0x27, 0xA6, 0x35, 0x36, 0x27, 0x25, 0x28, 0x25, 0x2F, 0x02, 0xF0,
+	0x24, 0x74, 0x24, 0x74, 0x28, 0x25, 0x37, 0x26, 0x35, 0x37, 0xA9, 0x60, 0xFF, 0xF7, 0x62, 0x63,
+	0x62, 0x65, 0x26, 0x27, 0x26, 0x27, 0x26, 0x27, 0x26, 0x27, 0xA7, 0xA7, 0x26, 0x27, 0x26, 0x27,
+	0x26, 0x27, 0x26, 0x25, 0x62, 0x63, 0x62, 0x60, 0xFF, 0xF9, 0xA7, 0xAB, 0x2F, 0x02, 0xF0, 0x2F,
+	0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xBA, 0x7A, 0xFF, 0xFB, 0xA7, 0xAC,
+	0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x27, 0x26, 0x27, 0x26, 0x27, 0x26, 0x27, 0x26, 0x27, 0x25,
+	0x28, 0x9A, 0x50, 0xFF, 0xF7, 0x72, 0x53, 0x72, 0x55, 0x25, 0x28, 0x24, 0x29, 0x23, 0x2A, 0x22,
+	0x2B, 0x21, 0x3B, 0x7A, 0x32, 0x39, 0x24, 0x38, 0x25, 0x28, 0x25, 0x35, 0x73, 0x52, 0x73, 0x50,
+	0xFF, 0xF7, 0x89, 0x8C, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x26, 0x27, 0x26,
+	0x27, 0x26, 0x27, 0x26, 0x24, 0xD4, 0xD0, 0xFF, 0xF6, 0x48, 0x41, 0x56, 0x53, 0x36, 0x35, 0x44,
+	0x45, 0x44, 0x45, 0x21, 0x22, 0x21, 0x25, 0x21, 0x22, 0x21, 0x25, 0x22, 0x42, 0x25, 0x22, 0x42,
+	0x25, 0x23, 0x23, 0x25, 0x28, 0x25, 0x28, 0x23, 0x72, 0x71, 0x72, 0x70, 0xFF, 0xF7, 0x43, 0x73,
+	0x43, 0x75, 0x35, 0x27, 0x44, 0x27, 0x53, 0x27, 0x21, 0x23, 0x27, 0x21, 0x32, 0x27, 0x22, 0x31,
+	0x27, 0x23, 0x21, 0x27, 0x23, 0x57, 0x24, 0x47, 0x25, 0x35, 0x73, 0x25, 0x73, 0x20, 0xFF, 0xFC,
+	0x4B, 0x88, 0x34, 0x37, 0x26, 0x26, 0x36, 0x35, 0x28, 0x25, 0x28, 0x25, 0x28, 0x25, 0x28, 0x25,
+	0x36, 0x36, 0x26, 0x27, 0x34, 0x38, 0x8B, 0x40, 0xFF, 0xF8, 0xA7, 0xB8, 0x25, 0x37, 0x26, 0x27,
+	0x26, 0x27, 0x26, 0x27, 0x25, 0x28, 0x98, 0x7A, 0x2F, 0x02, 0xF0, 0x2D, 0x89, 0x80, 0xFF, 0xFC,
+	0x4B, 0x88, 0x34, 0x37, 0x26, 0x26, 0x36, 0x35, 0x28, 0x25, 0x28, 0x25, 0x28, 0x25, 0x28, 0x25,
+	0x36, 0x36, 0x26, 0x27, 0x34, 0x38, 0x8A, 0x5C, 0x52, 0x27, 0xA7, 0x24, 0x30, 0xFF, 0xF7, 0xA7,
+	0xB8, 0x25, 0x37, 0x26, 0x27, 0x26, 0x27, 0x25, 0x37, 0x98, 0x7A, 0x23, 0x39, 0x24, 0x38, 0x25,
+	0x28, 0x25, 0x35, 0x73, 0x43, 0x74, 0x30, 0xFF, 0xFB, 0x51, 0x28, 0x97, 0x34, 0x37, 0x26, 0x27,
+	0x26, 0x27, 0x4E, 0x6D, 0x6E, 0x47, 0x26, 0x27, 0x26, 0x27, 0x34, 0x37, 0x98, 0x21, 0x50, 0xFF,
+	0xF8, 0xC5, 0xC5, 0x23, 0x23, 0x25, 0x23, 0x23, 0x25, 0x23, 0x23, 0x25, 0x23, 0x23, 0x2A, 0x2F,
+	0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xC8, 0x98, 0xFF, 0xF7, 0x62, 0x63, 0x62, 0x65, 0x26,
+	0x27, 0x26, 0x27, 0x26, 0x27, 0x26, 0x27, 0x26, 0x27, 0x26, 0x27, 0x26, 0x27, 0x26, 0x27, 0x26,
+	0x28, 0x24, 0x29, 0x8B, 0x40, 0xFF, 0xF7, 0x71, 0x72, 0x71, 0x74, 0x27, 0x27, 0x25, 0x28, 0x25,
+	0x28, 0x25, 0x29, 0x23, 0x2A, 0x23, 0x2B, 0x21, 0x2C, 0x21, 0x2C, 0x21, 0x2D, 0x3E, 0x3F, 0x01,
+	0xFF, 0xF6, 0x73, 0xE3, 0x72, 0x29, 0x24, 0x29, 0x24, 0x24, 0x14, 0x25, 0x22, 0x32, 0x26, 0x22,
+	0x32, 0x26, 0x21, 0x21, 0x21, 0x26, 0x21, 0x21, 0x21, 0x26, 0x42, 0x57, 0x33, 0x38, 0x33, 0x38,
+	0x25, 0x28, 0x25, 0x20, 0xFF, 0xF7, 0x62, 0x63, 0x62, 0x65, 0x26, 0x28, 0x24, 0x2A, 0x22, 0x2C,
+	0x4E, 0x2F, 0x02, 0xE4, 0xC2, 0x22, 0xA2, 0x42, 0x82, 0x62, 0x56, 0x26, 0x36, 0x26, 0xFF, 0xF7,
+	0x53, 0x63, 0x53, 0x65, 0x26, 0x28, 0x24, 0x2A, 0x22, 0x2B, 0x22, 0x2C, 0x4E, 0x2F, 0x02, 0xF0,
+	0x2F, 0x02, 0xF0, 0x2C, 0x89, 0x80, 0xFF, 0xF9, 0xA7, 0xA7, 0x26, 0x27, 0x25, 0x28, 0x24, 0x29,
+	0x23, 0x2E, 0x2E, 0x2E, 0x24, 0x28, 0x25, 0x27, 0x26, 0x26, 0x27, 0x26, 0xB6, 0xB0, 0xFF, 0xB5,
+	0xC5, 0xC2, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2F,
+	0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x05, 0xC5, 0x32, 0xF0, 0x2F, 0x03, 0xF0, 0x2F, 0x03, 0xF0,
+	0x2F, 0x02, 0xF1, 0x2F, 0x02, 0xF1, 0x2F, 0x02, 0xF1, 0x2F, 0x02, 0xF1, 0x2F, 0x02, 0xF0, 0x3F,
+	0x02, 0xF0, 0x3F, 0x02, 0xF0, 0x20, 0xFF, 0x85, 0xC5, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0,
+	0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xC5, 0xC5,
+	0xFA, 0x1F, 0x03, 0xD5, 0xB3, 0x13, 0xA2, 0x32, 0x92, 0x52, 0x72, 0x72, 0x61, 0x91, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0x11, 0xF1, 0xF8, 0x2F, 0x03,
+	0xF1, 0x3F, 0x02, 0xFF, 0xFF, 0xFF, 0xF1, 0x6A, 0x8F, 0x12, 0xF0, 0x2A, 0x78, 0x97, 0x35, 0x27,
+	0x26, 0x27, 0x25, 0x38, 0xB7, 0x51, 0x40, 0xFF, 0x54, 0xD4, 0xF0, 0x2F, 0x02, 0xF0, 0x21, 0x59,
+	0xA7, 0x35, 0x27, 0x27, 0x26, 0x27, 0x26, 0x27, 0x26, 0x27, 0x26, 0x27, 0x26, 0x35, 0x25, 0xC5,
+	0x41, 0x50, 0xFF, 0xFF, 0xFF, 0xF3, 0x51, 0x27, 0xA6, 0x35, 0x35, 0x37, 0x25, 0x28, 0x25, 0x2F,
+	0x02, 0xF0, 0x37, 0x26, 0x35, 0x37, 0x9A, 0x60, 0xFF, 0xD4, 0xD4, 0xF0, 0x2F, 0x02, 0x95, 0x12,
+	0x7A, 0x72, 0x53, 0x62, 0x72, 0x62, 0x72, 0x62, 0x72, 0x62, 0x72, 0x62, 0x72, 0x72, 0x53, 0x7C,
+	0x75, 0x14, 0xFF, 0xFF, 0xFF, 0xF2, 0x69, 0xA7, 0x26, 0x26, 0x28, 0x25, 0xC5, 0xC5, 0x2F, 0x02,
+	0xF1, 0x27, 0x26, 0xB8, 0x70, 0xFF, 0xB7, 0x98, 0x82, 0xF0, 0x2C, 0xB6, 0xB9, 0x2F, 0x02, 0xF0,
+	0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2C, 0xA7, 0xA0, 0xFF, 0xFF, 0xFF, 0xF2, 0x51, 0x45, 0xC5,
+	0x25, 0x36, 0x27, 0x26, 0x27, 0x26, 0x27, 0x26, 0x27, 0x26, 0x27, 0x27, 0x25, 0x37, 0xA9, 0x51,
+	0x2F, 0x02, 0xF0, 0x2E, 0x38, 0x89, 0x60, 0xFF, 0x54, 0xD4, 0xF0, 0x2F, 0x02, 0xF0, 0x21, 0x59,
+	0x98, 0x34, 0x37, 0x26, 0x27, 0x26, 0x27, 0x26, 0x27, 0x26, 0x27, 0x26, 0x27, 0x26, 0x25, 0x62,
+	0x63, 0x62, 0x60, 0xFF, 0xB2, 0xF0, 0x2F, 0xFF, 0x06, 0xB6, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02,
+	0xF0, 0x2F, 0x02, 0xF0, 0x2A, 0xC5, 0xC0, 0xFF, 0xC2, 0xF0, 0x2F, 0xFE, 0x98, 0x9F, 0x02, 0xF0,
+	0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xE3, 0x88,
+	0x96, 0xFF, 0x64, 0xD4, 0xF0, 0x2F, 0x02, 0xF0, 0x22, 0x58, 0x22, 0x58, 0x22, 0x2B, 0x21, 0x2C,
+	0x5C, 0x4D, 0x5C, 0x21, 0x3B, 0x22, 0x38, 0x43, 0x55, 0x43, 0x50, 0xFF, 0x76, 0xB6, 0xF0, 0x2F,
+	0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2A, 0xC5,
+	0xC0, 0xFF, 0xFF, 0xFF, 0xC4, 0x13, 0x14, 0x4E, 0x53, 0x23, 0x22, 0x52, 0x32, 0x32, 0x52, 0x32,
+	0x32, 0x52, 0x32, 0x32, 0x52, 0x32, 0x32, 0x52, 0x32, 0x32, 0x52, 0x32, 0x32, 0x36, 0x14, 0x14,
+	0x16, 0x14, 0x14, 0xFF, 0xFF, 0xFF, 0xD4, 0x15, 0x7B, 0x83, 0x43, 0x72, 0x62, 0x72, 0x62, 0x72,
+	0x62, 0x72, 0x62, 0x72, 0x62, 0x72, 0x62, 0x56, 0x26, 0x36, 0x26, 0xFF, 0xFF, 0xFF, 0xF3, 0x4B,
+	0x88, 0x34, 0x36, 0x36, 0x35, 0x28, 0x25, 0x28, 0x25, 0x28, 0x25, 0x36, 0x36, 0x34, 0x38, 0x8B,
+	0x40, 0xFF, 0xFF, 0xFF, 0xD4, 0x15, 0x7C, 0x73, 0x52, 0x72, 0x72, 0x62, 0x72, 0x62, 0x72, 0x62,
+	0x72, 0x62, 0x72, 0x63, 0x52, 0x7A, 0x72, 0x15, 0x92, 0xF0, 0x2F, 0x02, 0xD7, 0xA7, 0xFF, 0xFF,
+	0xFF, 0xF2, 0x51, 0x45, 0xC5, 0x25, 0x36, 0x27, 0x26, 0x27, 0x26, 0x27, 0x26, 0x27, 0x26, 0x27,
+	0x27, 0x25, 0x37, 0xA9, 0x51, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xC7, 0xA7, 0xFF, 0xFF, 0xFF, 0xE5,
+	0x24, 0x65, 0x16, 0x85, 0x22, 0x83, 0xE2, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xCA, 0x7A, 0xFF,
+	0xFF, 0xFF, 0xF2, 0x88, 0x97, 0x26, 0x27, 0x26, 0x27, 0x6C, 0x8D, 0x57, 0x26, 0x27, 0x25, 0x37,
+	0x98, 0x80, 0xFF, 0x82, 0xF0, 0x2F, 0x02, 0xF0, 0x2D, 0xA7, 0xA9, 0x2F, 0x02, 0xF0, 0x2F, 0x02,
+	0xF0, 0x2F, 0x02, 0xF0, 0x25, 0x38, 0x99, 0x60, 0xFF, 0xFF, 0xFF, 0xD4, 0x44, 0x54, 0x44, 0x72,
+	0x62, 0x72, 0x62, 0x72, 0x62, 0x72, 0x62, 0x72, 0x62, 0x72, 0x62, 0x72, 0x53, 0x8B, 0x75, 0x14,
+	0xFF, 0xFF, 0xFF, 0xD5, 0x45, 0x35, 0x45, 0x52, 0x62, 0x72, 0x62, 0x82, 0x42, 0x92, 0x42, 0xA2,
+	0x22, 0xB2, 0x22, 0xB6, 0xC4, 0xD4, 0xFF, 0xFF, 0xFF, 0xD4, 0x54, 0x44, 0x54, 0x52, 0x31, 0x32,
+	0x62, 0x23, 0x22, 0x62, 0x23, 0x22, 0x72, 0x11, 0x11, 0x12, 0x84, 0x14, 0x84, 0x14, 0x83, 0x32,
+	0xA2, 0x32, 0xA2, 0x32, 0xFF, 0xFF, 0xFF, 0xE5, 0x25, 0x55, 0x25, 0x72, 0x42, 0xA2, 0x22, 0xC4,
+	0xE2, 0xE4, 0xC2, 0x22, 0xA2, 0x42, 0x75, 0x25, 0x55, 0x25, 0xFF, 0xFF, 0xFF, 0xD6, 0x45, 0x26,
+	0x45, 0x42, 0x72, 0x72, 0x52, 0x82, 0x52, 0x92, 0x32, 0xA2, 0x32, 0xB2, 0x12, 0xC5, 0xD3, 0xF0,
+	0x2E, 0x2F, 0x02, 0xE2, 0xB8, 0x98, 0xFF, 0xFF, 0xFF, 0xF0, 0xA7, 0xA7, 0x25, 0x28, 0x24, 0x2E,
+	0x2E, 0x2E, 0x2E, 0x24, 0x28, 0x25, 0x27, 0xA7, 0xA0, 0xFF, 0xC3, 0xD4, 0xD2, 0xF0, 0x2F, 0x02,
+	0xF0, 0x2F, 0x02, 0xF0, 0x2E, 0x3D, 0x3F, 0x03, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2F,
+	0x04, 0xE3, 0xFF, 0xB2, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02,
+	0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x20, 0xFF, 0x93,
+	0xE4, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xF0, 0x3F, 0x03, 0xD3, 0xE2, 0xF0,
+	0x2F, 0x02, 0xF0, 0x2F, 0x02, 0xD4, 0xD3, 0xFF, 0xFF, 0xFF, 0xFF, 0xF5, 0x3D, 0x53, 0x26, 0x31,
+	0x31, 0x36, 0x23, 0x5D, 0x30,
+};
+
+static const uint16_t Font24_RLE_Offsets[96] = {
+	0x0000, 0x0000, 0x0011, 0x0021, 0x003E, 0x005B, 0x0073, 0x008A,
+	0x0095, 0x00AB, 0x00C0, 0x00D0, 0x00E3, 0x00F3, 0x00FA, 0x0105,
+	0x011D, 0x0138, 0x014E, 0x0162, 0x0177, 0x018E, 0x01A5, 0x01BC,
+	0x01D0, 0x01E9, 0x0200, 0x020D, 0x021D, 0x022F, 0x0238, 0x024A,
+	0x025C, 0x027E, 0x0297, 0x02AF, 0x02C7, 0x02E1, 0x02FB, 0x0312,
+	0x032C, 0x0348, 0x035C, 0x0373, 0x0390, 0x03A7, 0x03CC, 0x03EE,
+	0x0408, 0x041E, 0x043D, 0x0457, 0x046F, 0x0489, 0x04A5, 0x04C0,
+	0x04E4, 0x04FE, 0x0516, 0x052E, 0x0548, 0x0566, 0x0580, 0x058E,
+	0x059D, 0x05A3, 0x05B7, 0x05D2, 0x05E8, 0x0602, 0x0615, 0x0629,
+	0x0647, 0x0663, 0x0677, 0x0691, 0x06AB, 0x06C1, 0x06E3, 0x06FB,
+	0x0711, 0x072E, 0x074C, 0x075F, 0x0772, 0x0788, 0x07A0, 0x07B6,
+	0x07D4, 0x07EA, 0x0806, 0x0819, 0x0832, 0x084E, 0x0867, 0x0875,
+};
+
+sFONT Font24_RLE = {
+	NULL,
+	17, /* Width */
+	24, /* Height */
+	Font24_RLE_Data,
+	Font24_RLE_Offsets,
+};
+
@@ -1,15 +1,33 @@
 #include "mgos.h"
 #include "gfxfont.h"
+#include "epdbits.h"
 
 
 
 static GFXfont *s_font = NULL;
 static enum GFXfont_t s_font_type = GFXFONT_NONE;
+static uint32_t s_font_generation = 0;	// goes up whenever the font is set
 
 
 
+// -----------------------------------------------------------------------------
+// Number of glyphs in the glyph array of f.
+static uint16_t gfxfont_glyph_count(const GFXfont *f)
+{
+	uint16_t i, count = 0;
+
+	if (!f->ranges)
+		return f->last - f->first + 1;
+	for (i=0; i<f->range_count; i++) {
+		if (f->ranges[i].glyph + f->ranges[i].count > count)
+			count = f->ranges[i].glyph + f->ranges[i].count;
+	}
+	return count;
+}
+
+
 static bool ili9341_analyzeFont(GFXfont *f) {
-	int chars = f->last - f->first;
+	int chars = gfxfont_glyph_count(f);
 	int maxHeight=0, minyo=0, maxWidth=0, maxAdvance=0, minxo=0, maxxo=0, maxhyo=0, minhyo=0, maxyo=0, maxwxo=0, minwxo=0;
 
 	for (int i=0; i<chars; i++) {
@@ -20,7 +38,7 @@ static bool ili9341_analyzeFont(GFXfont *f) {
 		int8_t   xa = glyph->xAdvance;
 		int8_t   yo = glyph->yOffset;
 
-		LOG(LL_DEBUG, ("char=0x%02x '%c' w=%d h=%d xOffset=%d yOffset=%d xAdvance=%d", i+f->first, i+f->first, w, h, xo, yo, xa));
+		LOG(LL_DEBUG, ("glyph=%d w=%d h=%d xOffset=%d yOffset=%d xAdvance=%d", i, w, h, xo, yo, xa));
 		if (h+yo>maxhyo) maxhyo=h+yo;
 		if (-(h+yo)>minhyo) minhyo=h+yo;
 		if (w+xo>maxwxo) maxwxo=w+xo;
@@ -47,91 +65,230 @@ static bool ili9341_analyzeFont(GFXfont *f) {
 
 
 // -----------------------------------------------------------------------------
-//
-uint16_t ili9341_print_fillPixelLine(char *string, uint8_t line, uint8_t *buf, uint8_t color)
+// Decode the UTF-8 character at *s and move *s past it. Bytes that don't
+// start a well formed character decode to U+FFFD one at a time.
+uint32_t gfxfont_utf8_next(const char **s)
+{
+	const unsigned char *p = (const unsigned char *) *s;
+	uint32_t cp, min;
+	int n, i;
+
+	if (p[0] < 0x80) {
+		*s += 1;
+		return p[0];
+	} else if ((p[0] & 0xE0) == 0xC0) {
+		cp = p[0] & 0x1F; n = 1; min = 0x80;
+	} else if ((p[0] & 0xF0) == 0xE0) {
+		cp = p[0] & 0x0F; n = 2; min = 0x800;
+	} else if ((p[0] & 0xF8) == 0xF0) {
+		cp = p[0] & 0x07; n = 3; min = 0x10000;
+	} else {
+		*s += 1;
+		return 0xFFFD;
+	}
+
+	for (i=1; i<=n; i++) {
+		// also stops at the terminating 0
+		if ((p[i] & 0xC0) != 0x80) {
+			*s += 1;
+			return 0xFFFD;
+		}
+		cp = (cp << 6) | (p[i] & 0x3F);
+	}
+	*s += n + 1;
+	if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF))
+		return 0xFFFD;
+	return cp;
+}
+
+
+// -----------------------------------------------------------------------------
+// Glyph of a codepoint, NULL if f doesn't have it. Sparse fonts are a
+// binary search over their ranges.
+const GFXglyph *gfxfont_glyph_lookup(const GFXfont *f, uint32_t codepoint)
+{
+	int lo = 0, hi;
+
+	if (!f->ranges) {
+		if (codepoint < f->first || codepoint > f->last)
+			return NULL;
+		return f->glyph + (codepoint - f->first);
+	}
+
+	hi = f->range_count - 1;
+	while (lo <= hi) {
+		const int mid = (lo + hi) / 2;
+		const struct gfxfont_range *r = &f->ranges[mid];
+
+		if (codepoint < r->first)
+			hi = mid - 1;
+		else if (codepoint - r->first >= r->count)
+			lo = mid + 1;
+		else
+			return f->glyph + r->glyph + (codepoint - r->first);
+	}
+	return NULL;
+}
+
+
+// -----------------------------------------------------------------------------
+// Lay out the first len bytes of the UTF-8 string in font f: glyph and
+// bitmap left edge of every character, characters missing from the font
+// become ' ' or are left out if there is no ' ' either. Returns the line
+// width; glyphs may be NULL to only measure.
+static uint16_t gfxfont_layout(const GFXfont *f, const char *string, size_t len, struct gfxfont_run_glyph *glyphs, uint16_t *count)
 {
+	const GFXglyph *space = gfxfont_glyph_lookup(f, ' ');
 	uint16_t pixelline_width=0;
-	uint8_t  *bitmap;
-	uint16_t xx=0;
-	uint16_t bitpos, bytepos;
- 
-	if (!s_font || !string || !buf)
-		return 0;
-	bitmap = s_font->bitmap;
-
-//  LOG(LL_DEBUG, ("Line %d of string '%s'", line, string));
-	for (uint16_t i=0; i<strlen(string); i++)
-	{
-		if(string[i]<s_font->first || string[i]>s_font->last) {
-			LOG(LL_DEBUG, ("String character 0x%02x is not in font, replacing with ' '", i));
-			string[i]=' ';
+	uint16_t n=0;
+	const char *p = string;
+	const char *end = string + len;
+
+	while (p < end && *p) {
+		const uint32_t c = gfxfont_utf8_next(&p);
+		const GFXglyph *glyph = gfxfont_glyph_lookup(f, c);
+
+		if (!glyph) {
+			LOG(LL_DEBUG, ("String character U+%04X is not in font, using ' '", (unsigned) c));
+			if (!(glyph = space))
+				continue;
 		}
-		GFXglyph *glyph  = s_font->glyph+(string[i]-s_font->first);
 		uint8_t  w  = glyph->width;
-		uint8_t  h  = glyph->height;
 		int8_t   xo = glyph->xOffset;
-		int8_t   yo = glyph->yOffset;
 		int8_t   xa = glyph->xAdvance;
-		uint16_t bo = glyph->bitmapOffset;
-		uint16_t bo_bitoffset = glyph->width*(line- (yo-s_font->font_min_yOffset));
-		uint8_t  bits;
-		uint16_t fl=0, ll=0;
 
-//    LOG(LL_DEBUG, ("char=0x%02x '%c' w=%d h=%d xOffset=%d yOffset=%d xAdvance=%d bo=%d bo_bitoffset=%d", string[i], string[i], w, h, xo, yo, xa, bo, bo_bitoffset));
 		if (xo<0 && pixelline_width==0) {
-//      LOG(LL_DEBUG, ("First glyph '%c' has negative xOffset, adding %d to length", string[i], -xo));
 			pixelline_width=-xo;
 		}
-
-		// First and last line of char
-		fl = yo-s_font->font_min_yOffset;
-		ll = fl+h-1;
-
-		if (line < fl || line > ll) {
-//      LOG(LL_DEBUG, ("Glyph '%c' goes from line [%d..%d], skipping", string[i], fl, ll));
-		} else {
-			bo+=(bo_bitoffset/8);
-			bo_bitoffset%=8;
-//      	LOG(LL_DEBUG, ("Glyph '%c' goes from [%d..%d] on lines [%d..%d], data bo=%d%%%d for %d bits", string[i], pixelline_width+xo, pixelline_width+xo+w-1, fl, ll, bo, bo_bitoffset, w));
-
-			bits=bitmap[bo];
-			bits<<=bo_bitoffset;
-
-			for (xx=pixelline_width+xo; xx<pixelline_width+xo+w; xx++) {
-				bytepos = xx >> 3;
-				bitpos = 7-(xx & 0x07);
-				if(bits & 0x80) {
-					// buf[xx] = color;
-					if( !color ) {
-						buf[bytepos] &= ~(1 << bitpos);
-					} else {
-						buf[bytepos] |= (1 << bitpos);
-					}
-				}
-
-				bits <<= 1;
-//        LOG(LL_DEBUG, ("bo=%d%%%d (%02x) pixel=%d", bo, bo_bitoffset, bit, xx));
-				if (!(++bo_bitoffset % 8)) {
-					bits = bitmap[++bo];
-				}
-			}
+		if (glyphs) {
+			glyphs[n].glyph = glyph;
+			glyphs[n].x = pixelline_width + xo;
 		}
+		n++;
 		pixelline_width+=xa;
-		if (string[i+1]==0 && w>xa+xo) {
-//      LOG(LL_DEBUG, ("Last glyph '%c' is wider than it advances, adding %d to length", string[i], w-xa+xo));
+		if ((p>=end || *p==0) && w>xa+xo) {
 			pixelline_width+=(w-xa+xo);
 		}
 	}
-//  LOG(LL_DEBUG, ("pixelline_width returns %d", pixelline_width));
+	if (count) {
+		*count = n;
+	}
 	return pixelline_width;
 }
 
 
+// -----------------------------------------------------------------------------
+// A text run resolves glyphs and positions once, so every scanline and
+// every measurement after that is a walk over the glyph array.
+struct gfxfont_run *gfxfont_run_create(const char *string)
+{
+	if (!string)
+		return NULL;
+	return gfxfont_run_create_n(string, strlen(string));
+}
+
+// The first len bytes of string only.
+struct gfxfont_run *gfxfont_run_create_n(const char *string, size_t len)
+{
+	struct gfxfont_run *run;
+	uint16_t count;
+
+	if (!s_font || !string)
+		return NULL;
+
+	gfxfont_layout(s_font, string, len, NULL, &count);
+	run = calloc(1, sizeof(*run) + count * sizeof(run->glyphs[0]));
+	if (!run)
+		return NULL;
+
+	run->font = s_font;
+	run->width = gfxfont_layout(s_font, string, len, run->glyphs, &run->count);
+	run->height = count ? s_font->font_height : 0;
+	return run;
+}
+
+void gfxfont_run_destroy(struct gfxfont_run **run)
+{
+	if (!*run)
+		return;
+	free(*run);
+	*run = NULL;
+}
+
+// -----------------------------------------------------------------------------
+// Packed bitmap of one glyph; file fonts read it through their cache.
+static const uint8_t *gfxfont_glyph_bitmap(const GFXfont *f, const GFXglyph *glyph)
+{
+	if (f->file)
+		return gfxfont_file_glyph_bitmap(f, glyph);
+	return f->bitmap + glyph->bitmapOffset;
+}
+
+
+// -----------------------------------------------------------------------------
+// Draw scanline `line` of the run into the 1bpp line buf, color 0 clears
+// the glyph bits, anything else sets them. buf holds the run width rounded
+// up to whole bytes. Returns the run width.
+uint16_t gfxfont_run_fill_line(const struct gfxfont_run *run, uint8_t line, uint8_t *buf, uint8_t color)
+{
+	if (!run)
+		return 0;
+	return gfxfont_run_fill_line_at(run, line, buf, 0, (run->width + 7) & ~0x07, color);
+}
+
+// -----------------------------------------------------------------------------
+// As gfxfont_run_fill_line(), with the run starting x0 pixels into buf and
+// clipped to the first buf_width pixels of it. Glyph rows sit at any bit
+// offset in the packed bitmap; they are moved up to 32 bits at a time,
+// shifted to the destination offset and merged.
+uint16_t gfxfont_run_fill_line_at(const struct gfxfont_run *run, uint8_t line, uint8_t *buf, uint16_t x0, uint16_t buf_width, uint8_t color)
+{
+	const GFXfont *f;
+	const uint8_t *bitmap;
+	uint16_t i;
+
+	if (!run || !buf)
+		return 0;
+	f = run->font;
+
+	for (i=0; i<run->count; i++) {
+		const GFXglyph *glyph = run->glyphs[i].glyph;
+		int      x  = x0 + run->glyphs[i].x;
+		int      w  = glyph->width;
+		// First line of char
+		int      fl = glyph->yOffset - f->font_min_yOffset;
+		uint32_t bit;
+
+		if (line < fl || line >= fl + glyph->height)
+			continue;
+
+		bitmap = gfxfont_glyph_bitmap(f, glyph);
+		if (!bitmap)
+			continue;
+
+		bit = w * (line - fl);
+		if (x + w > buf_width)
+			w = buf_width - x;
+		while (w > 0) {
+			const int n = (w > 32) ? 32 : w;
+			const uint32_t bits = epd_bits_fetch(bitmap, bit, n);
+
+			if (bits)
+				epd_bits_merge(buf, x, bits, n, color != 0);
+			bit += n;
+			x += n;
+			w -= n;
+		}
+	}
+	return run->width;
+}
+
+
 // -----------------------------------------------------------------------------
 //
-uint16_t mgos_ili9341_getStringHeight(char *string)
+uint16_t mgos_ili9341_getStringHeight(const char *string)
 {
-	if (!s_font || !string || strlen(string) == 0)
+	if (!s_font || !string || *string == 0)
 		return 0;
 	return s_font->font_height;
 }
@@ -139,44 +296,46 @@ uint16_t mgos_ili9341_getStringHeight(char *string)
 
 // -----------------------------------------------------------------------------
 //
-uint16_t mgos_ili9341_getStringWidth(char *string)
+uint16_t mgos_ili9341_getStringWidth(const char *string)
 {
-	uint16_t pixelline_width=0;
- 
 	if (!s_font || !string)
 		return 0;
+	return gfxfont_layout(s_font, string, strlen(string), NULL, NULL);
+}
 
-	for (uint16_t i=0; i<strlen(string); i++) {
-		if(string[i]<s_font->first || string[i]>s_font->last) {
-			LOG(LL_WARN, ("String character 0x%02x is not in font, replacing with ' '", i));
-			string[i]=' ';
-		}
-		GFXglyph *glyph  = s_font->glyph+(string[i]-s_font->first);
-		uint8_t  w  = glyph->width;
-		int8_t   xo = glyph->xOffset;
-		int8_t   xa = glyph->xAdvance;
-//    LOG(LL_DEBUG, ("char=0x%02x '%c' w=%d xOffset=%d xAdvance=%d", string[i], string[i], w, xo, xa));
 
-		if (xo<0 && pixelline_width==0) {
-//      LOG(LL_DEBUG, ("First character has negative xOffset, adding %d to length", -xo));
-			pixelline_width=-xo;
-		}
-//    LOG(LL_DEBUG, ("char goes from row [%d..%d], cursor at %d", pixelline_width+xo, pixelline_width+xo+w-1, pixelline_width));
-		pixelline_width+=xa;
-		if (string[i+1]==0 && w>xa+xo) {
-			LOG(LL_DEBUG, ("Last character is wider than it advances, adding %d to length", w-xa+xo));
-			pixelline_width+=(w-xa+xo);
-		}
-	}
+// -----------------------------------------------------------------------------
+// Width of the first len bytes of string.
+uint16_t gfxfont_text_width(const char *string, size_t len)
+{
+	if (!s_font || !string)
+		return 0;
+	return gfxfont_layout(s_font, string, len, NULL, NULL);
+}
 
-	return pixelline_width;
+
+const GFXfont *mgos_ili9341_get_font(void)
+{
+	return s_font;
+}
+
+
+// -----------------------------------------------------------------------------
+// Changes whenever a font is set. A file font that was freed and loaded
+// again can come back at the same address, so holders of text runs check
+// this as well as the font pointer.
+uint32_t mgos_ili9341_get_font_generation(void)
+{
+	return s_font_generation;
 }
 
 
 
 bool mgos_ili9341_set_font(GFXfont *f)
 {
-	if (s_font_type == GFXFONT_FILE && s_font) free(s_font);
+	if (f && f == s_font) return true;
+	if (s_font_type == GFXFONT_FILE && s_font) gfxfont_file_free(&s_font);
+	s_font_generation++;
 
 	if (!f) {
 		s_font_type = GFXFONT_NONE;
@@ -189,3 +348,21 @@ bool mgos_ili9341_set_font(GFXfont *f)
 	s_font_type = GFXFONT_INTERNAL;
 	return true;
 }
+
+
+// -----------------------------------------------------------------------------
+// Load a font file and make it the current font. It is freed again when
+// another font is set, text runs made with it must be gone by then.
+bool mgos_ili9341_set_font_file(const char *path)
+{
+	GFXfont *f = gfxfont_file_load(path);
+
+	if (!f)
+		return false;
+	mgos_ili9341_set_font(NULL);
+	ili9341_analyzeFont(f);
+	s_font = f;
+	s_font_type = GFXFONT_FILE;
+	s_font_generation++;
+	return true;
+}
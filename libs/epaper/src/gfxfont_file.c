@@ -0,0 +1,210 @@
+#include "mgos.h"
+#include "mgos_config.h"
+#include "common/queue.h"
+#include "gfxfont.h"
+
+/*
+ * GFXfonts loaded from the filesystem.
+ * Only the header and the glyph table are read when the font is loaded,
+ * glyph bitmaps are read when a glyph is first drawn and kept in a cache
+ * of epaper.font_cache_size bytes, least recently used ones go first.
+ * The file stays open while the font is in use.
+ */
+
+struct font_cache_entry {
+	TAILQ_ENTRY(font_cache_entry) entries;
+	uint16_t index;
+	uint16_t size;
+	uint8_t bits[];
+};
+
+struct gfxfont_file {
+	GFXfont font;
+	FILE *fp;
+	uint32_t bitmap_pos;			// file offset of the glyph bitmaps
+	uint32_t bitmap_size;
+	uint16_t count;
+	uint32_t *offsets;				// per glyph, into the bitmaps
+	struct font_cache_entry **cached;	// per glyph, NULL if not loaded
+	TAILQ_HEAD(font_cache_head, font_cache_entry) lru;
+	size_t cache_used;
+	size_t cache_size;
+};
+
+
+static uint16_t gfxfont_file_u16(const uint8_t *p)
+{
+	return p[0] | (p[1] << 8);
+}
+
+static uint32_t gfxfont_file_u32(const uint8_t *p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t) p[3] << 24);
+}
+
+static void gfxfont_file_evict(struct gfxfont_file *ff, struct font_cache_entry *e)
+{
+	TAILQ_REMOVE(&ff->lru, e, entries);
+	ff->cached[e->index] = NULL;
+	ff->cache_used -= sizeof(*e) + e->size;
+	free(e);
+}
+
+
+GFXfont *gfxfont_file_load(const char *path)
+{
+	uint8_t hdr[GFXFONT_FILE_HEADER_SIZE];
+	uint8_t rec[GFXFONT_FILE_GLYPH_SIZE];
+	struct gfxfont_file *ff = NULL;
+	struct gfxfont_range *ranges;
+	GFXglyph *glyphs;
+	FILE *fp;
+	uint16_t count, range_count, i;
+	uint32_t next = 0;
+
+	if (!path || !(fp = fopen(path, "rb"))) {
+		LOG(LL_ERROR, ("could not open font file '%s'", path ? path : "(null)"));
+		return NULL;
+	}
+
+	if ((fread(hdr, 1, sizeof(hdr), fp) != sizeof(hdr)) || memcmp(hdr, GFXFONT_FILE_MAGIC, 4) ||
+		(hdr[4] < 1) || (hdr[4] > GFXFONT_FILE_VERSION)) {
+		LOG(LL_ERROR, ("'%s' is not a version 1..%d font file", path, GFXFONT_FILE_VERSION));
+		goto err;
+	}
+	count = gfxfont_file_u16(&hdr[8]);
+	range_count = (hdr[4] >= 2) ? gfxfont_file_u16(&hdr[10]) : 0;
+	if (!range_count && ((hdr[6] < hdr[5]) || (count != hdr[6] - hdr[5] + 1))) {
+		LOG(LL_ERROR, ("'%s' has %u glyphs for 0x%02x..0x%02x", path, count, hdr[5], hdr[6]));
+		goto err;
+	}
+
+	/* one block: the font, its cache slots, bitmap offsets, ranges and glyph table,
+	 * in that order so each part is aligned */
+	ff = calloc(1, sizeof(*ff) + count * (sizeof(GFXglyph) + sizeof(uint32_t) + sizeof(struct font_cache_entry *)) +
+		range_count * sizeof(struct gfxfont_range));
+	if (!ff) {
+		LOG(LL_ERROR, ("could not malloc the glyph table of '%s'", path));
+		goto err;
+	}
+	ff->cached = (struct font_cache_entry **) (ff + 1);
+	ff->offsets = (uint32_t *) (ff->cached + count);
+	ranges = (struct gfxfont_range *) (ff->offsets + count);
+	glyphs = (GFXglyph *) (ranges + range_count);
+	ff->count = count;
+	ff->bitmap_size = gfxfont_file_u32(&hdr[12]);
+	ff->bitmap_pos = GFXFONT_FILE_HEADER_SIZE + count * GFXFONT_FILE_GLYPH_SIZE +
+		range_count * GFXFONT_FILE_RANGE_SIZE;
+	ff->cache_size = mgos_sys_config_get_epaper_font_cache_size();
+	TAILQ_INIT(&ff->lru);
+
+	for (i = 0; i < count; i++) {
+		if (fread(rec, 1, sizeof(rec), fp) != sizeof(rec)) {
+			LOG(LL_ERROR, ("'%s' is truncated", path));
+			goto err;
+		}
+		ff->offsets[i] = gfxfont_file_u32(&rec[0]);
+		glyphs[i].bitmapOffset = 0;
+		glyphs[i].width = rec[4];
+		glyphs[i].height = rec[5];
+		glyphs[i].xAdvance = rec[6];
+		glyphs[i].xOffset = (int8_t) rec[7];
+		glyphs[i].yOffset = (int8_t) rec[8];
+		if (ff->offsets[i] + (glyphs[i].width * glyphs[i].height + 7) / 8 > ff->bitmap_size) {
+			LOG(LL_ERROR, ("glyph %u of '%s' is out of bounds", i, path));
+			goto err;
+		}
+	}
+
+	/* ranges must be sorted, apart and inside the glyph table */
+	for (i = 0; i < range_count; i++) {
+		if (fread(rec, 1, GFXFONT_FILE_RANGE_SIZE, fp) != GFXFONT_FILE_RANGE_SIZE) {
+			LOG(LL_ERROR, ("'%s' is truncated", path));
+			goto err;
+		}
+		ranges[i].first = gfxfont_file_u32(&rec[0]);
+		ranges[i].count = gfxfont_file_u16(&rec[4]);
+		ranges[i].glyph = gfxfont_file_u16(&rec[6]);
+		if ((ranges[i].first < next) || (ranges[i].glyph + ranges[i].count > count)) {
+			LOG(LL_ERROR, ("range %u of '%s' is out of order or bounds", i, path));
+			goto err;
+		}
+		next = ranges[i].first + ranges[i].count;
+	}
+
+	ff->fp = fp;
+	ff->font.glyph = glyphs;
+	ff->font.first = hdr[5];
+	ff->font.last = hdr[6];
+	ff->font.yAdvance = hdr[7];
+	ff->font.file = ff;
+	ff->font.ranges = range_count ? ranges : NULL;
+	ff->font.range_count = range_count;
+	LOG(LL_INFO, ("loaded font '%s', %u glyphs in %u ranges, %u bytes of bitmaps", path, count,
+		range_count ? range_count : 1, ff->bitmap_size));
+	return &ff->font;
+
+err:
+	free(ff);
+	fclose(fp);
+	return NULL;
+}
+
+void gfxfont_file_free(GFXfont **font)
+{
+	struct gfxfont_file *ff;
+
+	if (!*font || !(*font)->file)
+		return;
+	ff = (*font)->file;
+	while (!TAILQ_EMPTY(&ff->lru)) {
+		gfxfont_file_evict(ff, TAILQ_FIRST(&ff->lru));
+	}
+	fclose(ff->fp);
+	free(ff);
+	*font = NULL;
+}
+
+/*
+ * Bitmap of a glyph of a file font, read in if it isn't cached. The
+ * pointer stays good until the next call.
+ */
+const uint8_t *gfxfont_file_glyph_bitmap(const GFXfont *font, const GFXglyph *glyph)
+{
+	struct gfxfont_file *ff = font->file;
+	struct font_cache_entry *e;
+	const uint16_t index = glyph - font->glyph;
+	const uint16_t size = (glyph->width * glyph->height + 7) / 8;
+
+	if (index >= ff->count)
+		return NULL;
+
+	if ((e = ff->cached[index])) {
+		if (e != TAILQ_FIRST(&ff->lru)) {
+			TAILQ_REMOVE(&ff->lru, e, entries);
+			TAILQ_INSERT_HEAD(&ff->lru, e, entries);
+		}
+		return e->bits;
+	}
+
+	while ((ff->cache_used + sizeof(*e) + size > ff->cache_size) && !TAILQ_EMPTY(&ff->lru)) {
+		gfxfont_file_evict(ff, TAILQ_LAST(&ff->lru, font_cache_head));
+	}
+
+	/* a glyph bigger than the whole cache still gets its one slot */
+	if (!(e = malloc(sizeof(*e) + size)))
+		return NULL;
+	e->index = index;
+	e->size = size;
+	if (fseek(ff->fp, ff->bitmap_pos + ff->offsets[index], SEEK_SET) ||
+		(fread(e->bits, 1, size, ff->fp) != size)) {
+		LOG(LL_ERROR, ("could not read glyph %u", index));
+		free(e);
+		return NULL;
+	}
+
+	TAILQ_INSERT_HEAD(&ff->lru, e, entries);
+	ff->cached[index] = e;
+	ff->cache_used += sizeof(*e) + size;
+	return e->bits;
+}
@@ -1,4 +1,58 @@
 #include "screen.h"
+#include "epaper.h"
+
+struct screen_rect {
+	int x0, y0, x1, y1;       // inclusive
+};
+
+static void screen_widget_rect(struct widget_t *w, struct screen_rect *r) {
+	r->x0 = w->x;
+	r->y0 = w->y;
+	r->x1 = w->x + w->w - 1;
+	r->y1 = w->y + w->h - 1;
+}
+
+static bool screen_rect_intersect(const struct screen_rect *a, const struct screen_rect *b, struct screen_rect *out) {
+	out->x0 = a->x0 > b->x0 ? a->x0 : b->x0;
+	out->y0 = a->y0 > b->y0 ? a->y0 : b->y0;
+	out->x1 = a->x1 < b->x1 ? a->x1 : b->x1;
+	out->y1 = a->y1 < b->y1 ? a->y1 : b->y1;
+	return out->x0 <= out->x1 && out->y0 <= out->y1;
+}
+
+// Take what o covers away from r, as far as the rest is still a rectangle:
+// o has to span r's whole width or height. Returns false if o covers all
+// of r.
+static bool screen_rect_cull(struct screen_rect *r, const struct screen_rect *o) {
+	if (o->x0 > r->x1 || o->x1 < r->x0 || o->y0 > r->y1 || o->y1 < r->y0)
+		return true;
+	if (o->x0 <= r->x0 && o->x1 >= r->x1) {
+		if (o->y0 <= r->y0 && o->y1 >= r->y1)
+			return false;
+		if (o->y0 <= r->y0)
+			r->y0 = o->y1 + 1;
+		else if (o->y1 >= r->y1)
+			r->y1 = o->y0 - 1;
+	} else if (o->y0 <= r->y0 && o->y1 >= r->y1) {
+		if (o->x0 <= r->x0)
+			r->x0 = o->x1 + 1;
+		else if (o->x1 >= r->x1)
+			r->x1 = o->x0 - 1;
+	}
+	return true;
+}
+
+// Invalidate what r overlaps of wl and every widget above it.
+static void screen_invalidate_from(struct widget_list_t *wl, const struct screen_rect *r) {
+	struct screen_rect wr, hit;
+
+	for (; wl; wl = SLIST_NEXT(wl, entries)) {
+		screen_widget_rect(wl->widget, &wr);
+		if (screen_rect_intersect(r, &wr, &hit))
+			widget_invalidate_rect(wl->widget, hit.x0 - wr.x0, hit.y0 - wr.y0,
+				hit.x1 - hit.x0 + 1, hit.y1 - hit.y0 + 1);
+	}
+}
 
 struct screen_t *screen_create(char *name) {
 	struct screen_t *screen = NULL;
@@ -71,14 +125,94 @@ exit:
 	return screen;
 }
 
+// The widgets stay with the caller, they are only taken off the screen.
 void screen_destroy(struct screen_t **s) {
+	struct widget_list_t *wl;
+	int i, j;
+
+	if (!*s)
+		return;
+	while ((wl = SLIST_FIRST(&(*s)->widget_entries))) {
+		SLIST_REMOVE_HEAD(&(*s)->widget_entries, entries);
+		wl->widget->_screen = NULL;
+		free(wl);
+	}
+	for (i = 0; i < SCREEN_GRID_DIM; i++)
+		for (j = 0; j < SCREEN_GRID_DIM; j++)
+			if ((*s)->grid[i][j].widgets) free((*s)->grid[i][j].widgets);
+	if ((*s)->tick_id) mgos_clear_timer((*s)->tick_id);
 	if ((*s)->name) free ((*s)->name);
 	free(*s);
 	*s = NULL;
 }
 
+static uint16_t screen_grid_index(uint16_t v) {
+	v /= SCREEN_GRID_CELL;
+	return v < SCREEN_GRID_DIM ? v : SCREEN_GRID_DIM - 1;
+}
+
+// The cells w overlaps, inclusive. False for an empty widget.
+static bool screen_grid_span(struct widget_t *w, uint16_t *c0, uint16_t *r0, uint16_t *c1, uint16_t *r1) {
+	if (w->w == 0 || w->h == 0)
+		return false;
+	*c0 = screen_grid_index(w->x);
+	*r0 = screen_grid_index(w->y);
+	*c1 = screen_grid_index(w->x + w->w - 1);
+	*r1 = screen_grid_index(w->y + w->h - 1);
+	return true;
+}
+
+// Put w into every cell it overlaps, above the widgets with the same or a
+// lower z, like in the list.
+static bool screen_grid_add(struct screen_t *s, struct widget_t *w) {
+	uint16_t c0, r0, c1, r1, c, r, i;
+
+	if (!screen_grid_span(w, &c0, &r0, &c1, &r1))
+		return true;
+	for (r = r0; r <= r1; r++) {
+		for (c = c0; c <= c1; c++) {
+			struct screen_grid_cell *cell = &s->grid[r][c];
+
+			if (cell->num == cell->size) {
+				uint16_t size = cell->size ? cell->size * 2 : 4;
+				struct widget_t **widgets = (struct widget_t **) realloc(cell->widgets, size * sizeof(*widgets));
+
+				if (!widgets)
+					return false;
+				cell->widgets = widgets;
+				cell->size = size;
+			}
+			for (i = 0; i < cell->num && cell->widgets[i]->z > w->z; i++);
+			memmove(&cell->widgets[i + 1], &cell->widgets[i], (cell->num - i) * sizeof(*cell->widgets));
+			cell->widgets[i] = w;
+			cell->num++;
+		}
+	}
+	return true;
+}
+
+static void screen_grid_remove(struct screen_t *s, struct widget_t *w) {
+	uint16_t c0, r0, c1, r1, c, r, i;
+
+	if (!screen_grid_span(w, &c0, &r0, &c1, &r1))
+		return;
+	for (r = r0; r <= r1; r++) {
+		for (c = c0; c <= c1; c++) {
+			struct screen_grid_cell *cell = &s->grid[r][c];
+
+			for (i = 0; i < cell->num; i++) {
+				if (cell->widgets[i] != w)
+					continue;
+				cell->num--;
+				memmove(&cell->widgets[i], &cell->widgets[i + 1], (cell->num - i) * sizeof(*cell->widgets));
+				break;
+			}
+		}
+	}
+}
+
 bool screen_widget_add(struct screen_t *s, struct widget_t *w) {
-	struct widget_list_t *wl;
+	struct widget_list_t *wl, *it, *prev = NULL;
 
 	if (!s || !w)
 		return false;
@@ -87,8 +221,24 @@ bool screen_widget_add(struct screen_t *s, struct widget_t *w) {
 	if (!wl) {
 		return false;
 	}
+	if (!screen_grid_add(s, w)) {
+		screen_grid_remove(s, w);
+		free(wl);
+		return false;
+	}
 	wl->widget = w;
-	SLIST_INSERT_HEAD(&s->widget_entries, wl, entries);
+	w->_screen = s;
+	// bottom to top, in the order they are drawn; last added on top of its z
+	SLIST_FOREACH(it, &s->widget_entries, entries) {
+		if (it->widget->z > w->z)
+			break;
+		prev = it;
+	}
+	if (prev)
+		SLIST_INSERT_AFTER(prev, wl, entries);
+	else
+		SLIST_INSERT_HEAD(&s->widget_entries, wl, entries);
+	screen_timer_update(s);
 	return true;
 }
 
@@ -105,18 +255,198 @@ struct widget_t *screen_widget_add_from_file(struct screen_t *s, char *fn) {
 
 bool screen_widget_destroy(struct screen_t *s, struct widget_t **w) {
 	struct widget_list_t *wl;
+	struct screen_rect r;
 
-	if (!s)
+	if (!s || !*w)
 		return false;
 	SLIST_FOREACH(wl, &s->widget_entries, entries) {
 		if (wl->widget == *w) {
+			screen_widget_rect(*w, &r);
 			SLIST_REMOVE(&s->widget_entries, wl, widget_list_t, entries);
+			screen_grid_remove(s, *w);
 			widget_destroy(w);
+			free(wl);
+			// whatever it covered shows again
+			if (r.x0 <= r.x1 && r.y0 <= r.y1)
+				screen_invalidate_from(SLIST_FIRST(&s->widget_entries), &r);
+			break;
 		}
 	}
+	screen_timer_update(s);
 	return true;
 }
 
+static void screen_damage_add(struct screen_t *s, const struct screen_rect *r) {
+	if (!s->damaged) {
+		s->damage_x0 = r->x0; s->damage_y0 = r->y0;
+		s->damage_x1 = r->x1; s->damage_y1 = r->y1;
+		s->damaged = true;
+		return;
+	}
+	if (r->x0 < s->damage_x0) s->damage_x0 = r->x0;
+	if (r->y0 < s->damage_y0) s->damage_y0 = r->y0;
+	if (r->x1 > s->damage_x1) s->damage_x1 = r->x1;
+	if (r->y1 > s->damage_y1) s->damage_y1 = r->y1;
+}
+
+// Take the opaque widgets above wl away from r, false if they hide all of it.
+static bool screen_widget_visible(struct widget_list_t *wl, struct screen_rect *r) {
+	struct screen_rect o;
+
+	for (wl = SLIST_NEXT(wl, entries); wl; wl = SLIST_NEXT(wl, entries)) {
+		if (!wl->widget->opaque || !wl->widget->handler)
+			continue;
+		screen_widget_rect(wl->widget, &o);
+		if (!screen_rect_cull(r, &o))
+			return false;
+	}
+	return true;
+}
+
+static void screen_rect_union(struct screen_rect *r, const struct screen_rect *o) {
+	if (o->x0 < r->x0) r->x0 = o->x0;
+	if (o->y0 < r->y0) r->y0 = o->y0;
+	if (o->x1 > r->x1) r->x1 = o->x1;
+	if (o->y1 > r->y1) r->y1 = o->y1;
+}
+
+// Draw every widget that was invalidated, bottom to top, each with its
+// pushes clipped to the part of its damage that opaque widgets above
+// don't hide, then refresh the panel once for all of them. Widgets get
+// EV_WIDGET_DRAW the first time and EV_WIDGET_REDRAW after that; a widget
+// nobody invalidated or that is hidden isn't touched. Widgets above a
+// drawn rect are drawn again where it overlaps them. Anything else
+// flagged with mgos_epdUpdateNeeded() goes out with the same refresh.
+//
+// The controller swaps its two RAM banks on every refresh, so a change
+// drawn in one frame is drawn once more in the next frame that refreshes,
+// for the other bank; otherwise it would come undone on that refresh.
+// Returns the number of widgets drawn.
+uint16_t screen_render(struct screen_t *s) {
+	struct widget_list_t *wl;
+	struct screen_rect r, d;
+	uint16_t drawn = 0;
+	bool refresh;
+
+	if (!s)
+		return 0;
+
+	s->damaged = false;
+	refresh = mgos_epdIsUpdateNeeded();
+	SLIST_FOREACH(wl, &s->widget_entries, entries) {
+		if (wl->widget->_dirty && wl->widget->handler) {
+			refresh = true;
+			break;
+		}
+	}
+
+	SLIST_FOREACH(wl, &s->widget_entries, entries) {
+		struct widget_t *w = wl->widget;
+		bool changed;
+
+		if ((!w->_dirty && !(refresh && w->_redo)) || !w->handler || w->w == 0 || w->h == 0)
+			continue;
+		if (!w->_drawn)
+			widget_invalidate(w);
+
+		// what changed, plus what the bank we're drawing to missed last frame
+		changed = w->_dirty;
+		d.x0 = w->_damage_x0; d.y0 = w->_damage_y0;
+		d.x1 = w->_damage_x1; d.y1 = w->_damage_y1;
+		if (w->_redo) {
+			r.x0 = w->_redo_x0; r.y0 = w->_redo_y0;
+			r.x1 = w->_redo_x1; r.y1 = w->_redo_y1;
+			if (changed)
+				screen_rect_union(&r, &d);
+		} else {
+			r = d;
+		}
+		// cleared before the handler runs, it may invalidate for the next frame
+		w->_dirty = false;
+		w->_redo = false;
+		if (!screen_widget_visible(wl, &r))
+			continue;
+
+		mgos_epd_set_push_clip(r.x0, r.y0, r.x1 - r.x0 + 1, r.y1 - r.y0 + 1);
+		w->handler(w->_drawn ? EV_WIDGET_REDRAW : EV_WIDGET_DRAW, w, NULL);
+		mgos_epd_clear_push_clip();
+		w->_drawn = true;
+		drawn++;
+
+		if (changed && screen_widget_visible(wl, &d)) {
+			w->_redo = true;
+			w->_redo_x0 = d.x0; w->_redo_y0 = d.y0;
+			w->_redo_x1 = d.x1; w->_redo_y1 = d.y1;
+		}
+
+		// pushes are clipped to whole bytes
+		r.x0 &= ~0x07;
+		r.x1 |= 0x07;
+		screen_damage_add(s, &r);
+		screen_invalidate_from(SLIST_NEXT(wl, entries), &r);
+	}
+
+	if (drawn)
+		mgos_epdUpdateNeeded();
+	mgos_epdUpdate();
+	return drawn;
+}
+
+// Bounding box of what the last screen_render() drew, false if it drew
+// nothing.
+bool screen_get_damage(struct screen_t *s, uint16_t *x, uint16_t *y, uint16_t *w, uint16_t *h) {
+	if (!s || !s->damaged)
+		return false;
+	if (x) *x = s->damage_x0;
+	if (y) *y = s->damage_y0;
+	if (w) *w = s->damage_x1 - s->damage_x0 + 1;
+	if (h) *h = s->damage_y1 - s->damage_y0 + 1;
+	return true;
+}
+
+static void screen_tick(void *arg);
+
+// Arm the screen's timer for the earliest widget deadline, or for right
+// away if a widget is waiting to be drawn.
+void screen_timer_update(struct screen_t *s) {
+	struct widget_list_t *wl;
+	int64_t now, next = -1;
+
+	if (!s)
+		return;
+	now = mgos_uptime_micros() / 1000;
+	SLIST_FOREACH(wl, &s->widget_entries, entries) {
+		struct widget_t *w = wl->widget;
+
+		if (w->_dirty && w->handler) {
+			next = now;
+			break;
+		}
+		if (w->timer_msec && (next < 0 || w->_timer_due < next))
+			next = w->_timer_due;
+	}
+
+	if (s->tick_id)
+		mgos_clear_timer(s->tick_id);
+	s->tick_id = 0;
+	if (next >= 0)
+		s->tick_id = mgos_set_timer(next > now ? next - now : 0, 0, screen_tick, s);
+}
+
+// Fire the timers of all widgets that are due, draw whatever they
+// invalidated with one panel refresh, and sleep until the next deadline.
+static void screen_tick(void *arg) {
+	struct screen_t *s = (struct screen_t *) arg;
+	struct widget_list_t *wl;
+	int64_t now = mgos_uptime_micros() / 1000 + SCREEN_TICK_SLACK_MSEC;
+
+	s->tick_id = 0;
+	SLIST_FOREACH(wl, &s->widget_entries, entries)
+		widget_timer_run(wl->widget, now);
+	screen_render(s);
+	screen_timer_update(s);
+}
+
 uint16_t screen_get_num_widgets(struct screen_t *s) {
 	struct widget_list_t *wl;
 	uint16_t num = 0;
@@ -129,19 +459,21 @@ uint16_t screen_get_num_widgets(struct screen_t *s) {
 	return num;
 }
 
+// The topmost widget at (x, y), looked up in the grid cell holding it.
 struct widget_t *screen_widget_find_by_xy(struct screen_t *s, uint16_t x, uint16_t y) {
-	struct widget_list_t *wl;
+	struct screen_grid_cell *cell;
+	uint16_t i;
 
 	if (!s)
 		return NULL;
 
-	SLIST_FOREACH(wl, &s->widget_entries, entries) {
-		LOG(LL_DEBUG, ("Inspecing widget '%s' (x=%d,y=%d,w=%d,h=%d)", wl->widget->name, wl->widget->x, wl->widget->y, wl->widget->w, wl->widget->h));
-		if (wl->widget->x <= x &&
-				x < (wl->widget->x+wl->widget->w) &&
-				wl->widget->y <= y &&
-				y < (wl->widget->y+wl->widget->h))
-			return wl->widget;
+	cell = &s->grid[screen_grid_index(y)][screen_grid_index(x)];
+	for (i = 0; i < cell->num; i++) {
+		struct widget_t *w = cell->widgets[i];
+
+		if (w->x <= x && x < (w->x+w->w) &&
+				w->y <= y && y < (w->y+w->h))
+			return w;
 	}
 	return NULL;
 }
@@ -0,0 +1,231 @@
+#include "mgos.h"
+#include "epaper.h"
+#include "textbox.h"
+
+#define TEXTBOX_ELLIPSIS "..."
+
+static void textbox_free_lines(struct textbox_t *tb) {
+	uint16_t i;
+
+	for (i=0; i<tb->num_lines; i++)
+		gfxfont_run_destroy(&tb->lines[i]);
+	free(tb->lines);
+	tb->lines = NULL;
+	tb->num_lines = 0;
+}
+
+static bool textbox_add_line(struct textbox_t *tb, struct gfxfont_run *run) {
+	struct gfxfont_run **lines;
+
+	if (!run)
+		return false;
+	lines = (struct gfxfont_run **) realloc(tb->lines, (tb->num_lines + 1) * sizeof(*lines));
+	if (!lines) {
+		gfxfont_run_destroy(&run);
+		return false;
+	}
+	tb->lines = lines;
+	tb->lines[tb->num_lines++] = run;
+	return true;
+}
+
+// End of the longest piece of the paragraph at start that fits in w pixels:
+// whole words if at least one fits, else as many characters as fit, but at
+// least one.
+static const char *textbox_break(const char *start, uint16_t w) {
+	const char *best = NULL, *p = start, *e;
+
+	while (true) {
+		for (e = p; *e && *e != ' ' && *e != '\n'; e++);
+		if (gfxfont_text_width(start, e - start) > w)
+			break;
+		best = e;
+		if (*e != ' ')
+			return best;
+		for (p = e; *p == ' '; p++);
+		if (!*p || *p == '\n')
+			return best;
+	}
+	if (best)
+		return best;
+
+	// a word wider than the box
+	p = start;
+	gfxfont_utf8_next(&p);
+	best = p;
+	while (*p && *p != ' ' && *p != '\n') {
+		gfxfont_utf8_next(&p);
+		if (gfxfont_text_width(start, p - start) > w)
+			break;
+		best = p;
+	}
+	return best;
+}
+
+// The last line when more text follows: as much of the rest as fits in
+// front of the ellipsis, cut at a character and without trailing spaces.
+static struct gfxfont_run *textbox_ellipsis_line(const char *start, uint16_t w) {
+	struct gfxfont_run *run;
+	const char *p = start, *end = start, *nl = strchr(start, '\n');
+	size_t len = nl ? (size_t) (nl - start) : strlen(start);
+	char *buf = malloc(len + sizeof(TEXTBOX_ELLIPSIS));
+
+	if (!buf)
+		return NULL;
+	while (p < start + len) {
+		const char *prev = p;
+
+		gfxfont_utf8_next(&p);
+		memcpy(&buf[prev - start], prev, p - prev);
+		memcpy(&buf[p - start], TEXTBOX_ELLIPSIS, sizeof(TEXTBOX_ELLIPSIS));
+		if (gfxfont_text_width(buf, p - start + strlen(TEXTBOX_ELLIPSIS)) > w)
+			break;
+		end = p;
+	}
+	while (end > start && end[-1] == ' ')
+		end--;
+	memcpy(&buf[end - start], TEXTBOX_ELLIPSIS, sizeof(TEXTBOX_ELLIPSIS));
+	run = gfxfont_run_create(buf);
+	free(buf);
+	return run;
+}
+
+// Break the text into lines in the current font.
+static void textbox_layout(struct textbox_t *tb) {
+	const GFXfont *f = mgos_ili9341_get_font();
+	const char *p, *e;
+	uint16_t max_lines;
+
+	textbox_free_lines(tb);
+	tb->font = f;
+	tb->font_generation = mgos_ili9341_get_font_generation();
+	tb->valid = true;
+	if (!f || !tb->text || tb->h < f->font_height || f->yAdvance == 0)
+		return;
+	max_lines = 1 + (tb->h - f->font_height) / f->yAdvance;
+
+	p = tb->text;
+	while (*p && tb->num_lines < max_lines) {
+		e = textbox_break(p, tb->w);
+		if (tb->ellipsis && tb->num_lines == max_lines - 1 && (e[strspn(e, " \n")] != 0)) {
+			textbox_add_line(tb, textbox_ellipsis_line(p, tb->w));
+			break;
+		}
+		if (!textbox_add_line(tb, gfxfont_run_create_n(p, e - p)))
+			break;
+		p = e + strspn(e, " ");
+		if (*p == '\n')
+			p++;
+	}
+	LOG(LL_DEBUG, ("laid out %u lines in %ux%u", tb->num_lines, tb->w, tb->h));
+}
+
+static void textbox_update(struct textbox_t *tb) {
+	if (!tb->valid || tb->font != mgos_ili9341_get_font() ||
+		tb->font_generation != mgos_ili9341_get_font_generation())
+		textbox_layout(tb);
+}
+
+// Left edge of a line for the alignment.
+static uint16_t textbox_line_x(const struct textbox_t *tb, const struct gfxfont_run *run) {
+	if (run->width >= tb->w || tb->align == TEXTBOX_ALIGN_LEFT)
+		return 0;
+	if (tb->align == TEXTBOX_ALIGN_RIGHT)
+		return tb->w - run->width;
+	return (tb->w - run->width) / 2;
+}
+
+static void textbox_row(const int row, uint8_t *buf, void *arg) {
+	const struct textbox_t *tb = (const struct textbox_t *) arg;
+	const int line = row / tb->font->yAdvance;
+	const int line_row = row - line * tb->font->yAdvance;
+
+	memset(buf, 0xFF, (tb->w + 7) / 8);
+	if (line < tb->num_lines && line_row < tb->lines[line]->height)
+		gfxfont_run_fill_line_at(tb->lines[line], line_row, buf, textbox_line_x(tb, tb->lines[line]), tb->w, 0);
+}
+
+
+struct textbox_t *textbox_create(uint16_t w, uint16_t h) {
+	struct textbox_t *tb;
+
+	tb = (struct textbox_t *) calloc(1, sizeof(*tb));
+	if (!tb)
+		return NULL;
+	tb->w = w;
+	tb->h = h;
+	tb->align = TEXTBOX_ALIGN_LEFT;
+	tb->ellipsis = true;
+	return tb;
+}
+
+void textbox_destroy(struct textbox_t **tb) {
+	if (!*tb)
+		return;
+	textbox_free_lines(*tb);
+	if ((*tb)->text)
+		free((*tb)->text);
+	free(*tb);
+	*tb = NULL;
+}
+
+// Returns true if the text changed.
+bool textbox_set_text(struct textbox_t *tb, const char *text) {
+	char *copy;
+
+	if (!tb)
+		return false;
+	if (!text)
+		text = "";
+	if (tb->text && !strcmp(tb->text, text))
+		return false;
+	if (!(copy = strdup(text)))
+		return false;
+	if (tb->text)
+		free(tb->text);
+	tb->text = copy;
+	tb->valid = false;
+	return true;
+}
+
+void textbox_set_size(struct textbox_t *tb, uint16_t w, uint16_t h) {
+	if (!tb || (tb->w == w && tb->h == h))
+		return;
+	tb->w = w;
+	tb->h = h;
+	tb->valid = false;
+}
+
+// Alignment doesn't change the line breaks, only where lines are drawn.
+void textbox_set_align(struct textbox_t *tb, enum textbox_align_t align) {
+	if (!tb)
+		return;
+	tb->align = align;
+}
+
+void textbox_set_ellipsis(struct textbox_t *tb, bool ellipsis) {
+	if (!tb || tb->ellipsis == ellipsis)
+		return;
+	tb->ellipsis = ellipsis;
+	tb->valid = false;
+}
+
+uint16_t textbox_get_num_lines(struct textbox_t *tb) {
+	if (!tb)
+		return 0;
+	textbox_update(tb);
+	return tb->num_lines;
+}
+
+// Draw the text box in the current font to the frame memory at (x, y),
+// the whole box in one RAM window, white where there is no text. x goes
+// down to a multiple of 8 like every push. This won't update the display.
+void textbox_draw(struct textbox_t *tb, uint16_t x, uint16_t y) {
+	if (!tb)
+		return;
+	textbox_update(tb);
+	// textbox_row() divides by yAdvance
+	if (!tb->font || tb->font->yAdvance == 0 || tb->w == 0 || tb->h == 0)
+		return;
+	mgos_epd_pushFrameBufferRows(x, y, (tb->w + 7) & ~0x07, tb->h, textbox_row, tb);
+}
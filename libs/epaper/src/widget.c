@@ -1,14 +1,25 @@
 #include "mgos.h"
 #include "widget.h"
+#include "screen.h"
 #include "frozen/frozen.h"
 #include "common/queue.h"
 
-static void widget_event_timer(void *arg) {
-	struct widget_t *widget = (struct widget_t *) arg;
-	if (!widget)
-		return;
-	if (widget->handler)
-		widget->handler(EV_WIDGET_TIMER, widget, NULL);
+// Deadlines fall on multiples of the period in uptime, so widgets with
+// the same or related periods come due at the same moment.
+static int64_t widget_timer_next(uint32_t timer_msec, int64_t now_msec) {
+	return (now_msec / timer_msec + 1) * timer_msec;
+}
+
+// Send EV_WIDGET_TIMER if the widget's deadline is at or before now_msec
+// and move the deadline past it. Ticks that were missed aren't made up.
+// Returns true if the widget fired.
+bool widget_timer_run(struct widget_t *w, int64_t now_msec) {
+	if (!w || w->timer_msec == 0 || w->_timer_due > now_msec)
+		return false;
+	w->_timer_due = widget_timer_next(w->timer_msec, now_msec);
+	if (w->handler)
+		w->handler(EV_WIDGET_TIMER, w, NULL);
+	return true;
 }
 
 void widget_destroy(struct widget_t **widget) {
@@ -17,9 +28,6 @@ void widget_destroy(struct widget_t **widget) {
 	if ((*widget)->handler)
 		(*widget)->handler(EV_WIDGET_DESTROY, *widget, NULL);
 
-	if ((*widget)->_timer_id)
-		mgos_clear_timer((*widget)->_timer_id);
-
 	if ((*widget)->user_data)
 		free((*widget)->user_data);
 
@@ -52,11 +60,18 @@ struct widget_t *widget_create(char *name, uint16_t x, uint16_t y, uint16_t w, u
 	widget->type=WIDGET_TYPE_NONE; 
 	widget->label=NULL;
 	widget->img=NULL;
+	widget->z = 0;
+	widget->opaque = false;
 	widget->user_data = NULL;
 	widget->handler = NULL;
 	widget->timer_msec = 0;
-	widget->_timer_id = 0;
+	widget->_timer_due = 0;
+	widget->_screen = NULL;
 	widget->create_called = false;
+	widget->_drawn = false;
+	widget->_dirty = false;
+	widget->_redo = false;
+	widget_invalidate(widget);
 
 	return widget;
 }
@@ -65,6 +80,8 @@ struct widget_t *widget_create_from_json(const char *json) {
 	struct widget_t *widget=NULL;
 	int x, y, w, h;
 	int type = 0;
+	int z = 0;
+	bool opaque = false;
 	char *name = NULL;
 	char *label = NULL;
 	char *img = NULL;
@@ -76,8 +93,10 @@ struct widget_t *widget_create_from_json(const char *json) {
 	widget = widget_create(name, x, y, w, h);
 	free(name);
 
-	json_scanf(json, strlen(json), "{type:%d,label:%Q,img:%Q}", &type, &label, &img);
+	json_scanf(json, strlen(json), "{type:%d,label:%Q,img:%Q,z:%d,opaque:%B}", &type, &label, &img, &z, &opaque);
 	widget->type=type;
+	widget->z=z;
+	widget->opaque=opaque;
 	widget->label=label;
 	widget->img=img;
 
@@ -116,17 +135,19 @@ void widget_delete_handler(struct widget_t *w) {
 	return;
 }
 
+// The timer runs once the widget is on a screen, which fires all widgets
+// that are due together and then refreshes the panel once.
 void widget_set_timer(struct widget_t *w, uint32_t timer_msec) {
 	if (!w)
 		return;
-	if (w->_timer_id)
-		mgos_clear_timer(w->_timer_id);
 
 	w->timer_msec=timer_msec; 
 	if (timer_msec == 0)
-		w->_timer_id = 0;
+		w->_timer_due = 0;
 	else 
-		w->_timer_id = mgos_set_timer(timer_msec, MGOS_TIMER_REPEAT, widget_event_timer, w);
+		w->_timer_due = widget_timer_next(timer_msec, mgos_uptime_micros() / 1000);
+	if (w->_screen)
+		screen_timer_update(w->_screen);
 
 	return;
 }
@@ -139,6 +160,46 @@ void widget_delete_timer(struct widget_t *w) {
 	return;
 }
 
+// Mark the whole widget for a redraw at the next screen_render().
+void widget_invalidate(struct widget_t *w) {
+	if (!w)
+		return;
+	widget_invalidate_rect(w, 0, 0, w->w, w->h);
+}
+
+// Mark part of the widget, x and y relative to its corner, for a redraw
+// at the next screen_render(), which the widget's screen schedules right away.
+// Handlers call this when something they show has changed; rects add up
+// to their bounding box until it's drawn.
+void widget_invalidate_rect(struct widget_t *widget, uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+	uint16_t x0, y0, x1, y1;
+
+	if (!widget || x >= widget->w || y >= widget->h || w == 0 || h == 0)
+		return;
+	if (w > widget->w - x)
+		w = widget->w - x;
+	if (h > widget->h - y)
+		h = widget->h - y;
+	x0 = widget->x + x;
+	y0 = widget->y + y;
+	x1 = x0 + w - 1;
+	y1 = y0 + h - 1;
+
+	if (!widget->_dirty) {
+		widget->_damage_x0 = x0; widget->_damage_y0 = y0;
+		widget->_damage_x1 = x1; widget->_damage_y1 = y1;
+		widget->_dirty = true;
+		// have the screen draw it soon, not only at the next timer deadline
+		if (widget->_screen)
+			screen_timer_update(widget->_screen);
+		return;
+	}
+	if (x0 < widget->_damage_x0) widget->_damage_x0 = x0;
+	if (y0 < widget->_damage_y0) widget->_damage_y0 = y0;
+	if (x1 > widget->_damage_x1) widget->_damage_x1 = x1;
+	if (y1 > widget->_damage_y1) widget->_damage_y1 = y1;
+}
+
 void widget_ev_to_str(int ev, char *s, int slen) {
 	switch(ev) {
 		case EV_WIDGET_CREATE:
@@ -4,59 +4,125 @@
 #include "epaper.h"
 
 #include "gfxfont.h"
+#include "textbox.h"
 #include "fonts/FreeSerif12pt7b.h"
 
 // extern GFXfont FreeSerifBold9pt7b;
 
-static void widget_time_render(struct widget_t *w, void *ev_data)
+#define TIME_BUF_W    128
+#define TIME_BUF_H    32
+#define TIME_TEXT_W   136           // "hh:mm:ss" in Font24
+
+// Where the parts sit, relative to the widget, which is TIME_TEXT_X +
+// TIME_TEXT_W wide so that all of them are inside it
+#define TIME_TEXT_X   8
+#define TIME_TEXT_Y   25
+#define TIME_BAR_Y    80
+
+// Private per-widget paint buffers, one per place on the panel so that
+// each keeps its own damage and only changed bytes are pushed.
+struct widget_time_data {
+  uint8_t text_buf[(TIME_TEXT_W / 8) * TIME_BUF_H];
+  uint8_t bar_buf[(TIME_BUF_W / 8) * TIME_BUF_H];
+  struct textbox_t *text;
+
+  // What is on the panel, or due to be at the next draw
+  char shown[32];
+  int bar;
+};
+
+static struct widget_time_data *widget_time_get_data(struct widget_t *w)
 {
-  sFONT *font = &Font24;
+  if (!w->user_data)
+    w->user_data = calloc(1, sizeof(struct widget_time_data));
+  return (struct widget_time_data *) w->user_data;
+}
+
+// Read the clock and invalidate the parts that show something different.
+static void widget_time_update(struct widget_t *w)
+{
+  struct widget_time_data *data;
   char tmp_buff[32];
-  int16_t text_width, text_height;
 
   time_t now = 2*3600 + time(0); // TZ=GMT+1
   struct tm* tm_info = gmtime(&now);
-  int i;
 
-  if (!w)
+  if (!(data = widget_time_get_data(w)))
     return;
 
-  mgos_ili9341_set_font(&FreeSerif12pt7b);
-
-//  mgos_ili9341_set_fgcolor565(ILI9341_YELLOW);
   sprintf(tmp_buff, "%02d:%02d:%02d", tm_info->tm_hour, tm_info->tm_min, tm_info->tm_sec);
-  printf("time: '%s'\n", tmp_buff);
+  if (strcmp(tmp_buff, data->shown)) {
+    strcpy(data->shown, tmp_buff);
+    printf("time: '%s'\n", tmp_buff);
+    // the text box and the Font24 copy below it
+    widget_invalidate_rect(w, 0, 0, w->w, TIME_TEXT_Y + Font24_RLE.Height);
+  }
+  if (data->bar != (tm_info->tm_sec & 0x0F)) {
+    data->bar = tm_info->tm_sec & 0x0F;
+    widget_invalidate_rect(w, 0, TIME_BAR_Y, TIME_BUF_W, TIME_BUF_H);
+  }
+}
 
-  #define _WW   (((0+(strlen(tmp_buff) * font->Width))+7) & 0xF8)
-  #define _HH   (0+(font->Height))
+static void widget_time_render(struct widget_t *w, void *ev_data)
+{
+  sFONT *font = &Font24_RLE;
+  struct widget_time_data *data;
+  const char *tmp_buff;
+  int16_t text_height;
+  uint8_t *saved_fb;
+  int saved_w, saved_h;
+  int i;
 
-  mgos_epd_set_width(_WW);
-  mgos_epd_set_height(_HH);
+  if (!w)
+    return;
 
-  text_width = mgos_ili9341_getStringWidth(tmp_buff);
-  text_height = mgos_ili9341_getStringHeight(tmp_buff);
+  if (!(data = widget_time_get_data(w)))
+    return;
+  tmp_buff = data->shown;
 
+  mgos_ili9341_set_font(&FreeSerif12pt7b);
 
-  mgos_epd_set_width(w->w);
-  mgos_epd_set_height(w->h);
-  printf("W=%d %d : %d %d\n", w->x, w->y, w->x + w->w, w->y + w->h);
+//  mgos_ili9341_set_fgcolor565(ILI9341_YELLOW);
 
-  mgos_epd_print(text_width > (w->w) ? 0:(w->w-text_width)/2, text_height>(w->h) ? 0:(w->h-text_height)/2, tmp_buff);
+  // One line, centered across the top of the widget
+  text_height = mgos_ili9341_getStringHeight(tmp_buff);
+  if (text_height > w->h)
+    text_height = w->h;
+  if (!data->text) {
+    data->text = textbox_create(w->w, text_height);
+    textbox_set_align(data->text, TEXTBOX_ALIGN_CENTER);
+  }
+  textbox_set_size(data->text, w->w, text_height);
+  textbox_set_text(data->text, tmp_buff);
+  textbox_draw(data->text, w->x, w->y);
 
   //
-  mgos_epd_set_width(128);
-  mgos_epd_set_height(32);
+  saved_fb = mgos_epd_getFrameBuffer();
+  saved_w = mgos_epd_get_width();
+  saved_h = mgos_epd_get_height();
+
+  mgos_epd_setFrameBuffer(data->text_buf);
+  mgos_epd_set_width(TIME_TEXT_W);
+  mgos_epd_set_height(TIME_BUF_H);
 
-  mgos_epd_draw_filled_rectangle(0, 0, _WW, _HH, 1);
+  mgos_epd_draw_filled_rectangle(0, 0, ((strlen(tmp_buff) * font->Width) + 7) & 0xF8, font->Height, 1);
   mgos_epd_draw_string_at(0, 0, tmp_buff, font, 0);
-  mgos_epd_pushFrameBuffer( mgos_epd_getFrameBuffer(), 40, 85, mgos_epd_get_width(), mgos_epd_get_height());
+  mgos_epd_pushDirty(w->x + TIME_TEXT_X, w->y + TIME_TEXT_Y);
+
+  mgos_epd_setFrameBuffer(data->bar_buf);
+  mgos_epd_set_width(TIME_BUF_W);
+  mgos_epd_set_height(TIME_BUF_H);
 
   mgos_epd_draw_filled_rectangle(0, 0, mgos_epd_get_width(), mgos_epd_get_height(), 1);
   mgos_epd_draw_rectangle(0, 0, mgos_epd_get_width()-1, mgos_epd_get_height()-1, 0);
-  for (i=0; i<=(tm_info->tm_sec & 0x0F); i++) {
+  for (i=0; i<=data->bar; i++) {
     mgos_epd_draw_filled_rectangle((8*i)+(i==0?3:0), 3, (8*i)+(i==15?4:5), 28, 0);
   }
-  mgos_epd_pushFrameBuffer( mgos_epd_getFrameBuffer(), (100 - 64), 140, mgos_epd_get_width(), mgos_epd_get_height());
+  mgos_epd_pushDirty(w->x, w->y + TIME_BAR_Y);
+
+  mgos_epd_setFrameBuffer(saved_fb);
+  mgos_epd_set_width(saved_w);
+  mgos_epd_set_height(saved_h);
 
   mgos_epdUpdateNeeded();
 
@@ -70,16 +136,21 @@ void widget_time_ev(int ev, struct widget_t *w, void *ev_data)
     return;
 
   switch(ev) {
-    case EV_WIDGET_CREATE:
     case EV_WIDGET_DRAW:
     case EV_WIDGET_REDRAW:
-    case EV_WIDGET_TIMER:
       widget_time_render(w, ev_data);
-//      mgos_epd_display_frame();
+      break;
+    case EV_WIDGET_CREATE:
+    case EV_WIDGET_TIMER:
+      // drawn by screen_render() if anything shown has changed
+      widget_time_update(w);
+      break;
+    case EV_WIDGET_DESTROY:
+      if (w->user_data)
+        textbox_destroy(&((struct widget_time_data *) w->user_data)->text);
       break;
     case EV_WIDGET_TOUCH_UP:
     case EV_WIDGET_TOUCH_DOWN:
-    case EV_WIDGET_DESTROY:
     default: // EV_WIDGET_NONE
       break;
   }
@@ -45,12 +45,6 @@
 uint8_t imagebuffer[1024];
 struct screen_t *screen = NULL;
 
-void epaper_timer_cb(void *param)
-{
-	mgos_epdUpdate();
-	(void)param;
-}
-
 
 // ---------------------------------------------------------------------------------
 //
@@ -87,16 +81,16 @@ void epaper_demo(void)
 
 	/* For simplicity, the arguments are explicit numerical coordinates */
 	mgos_epd_clear(COLORED);
-	mgos_epd_draw_string_at(2, 2, "Hello Mongoose!", &Font20, UNCOLORED);
+	mgos_epd_draw_string_at(2, 2, "Hello Mongoose!", &Font20_RLE, UNCOLORED);
 	mgos_epd_pushFrameBuffer(mgos_epd_getFrameBuffer(), 0, 10, mgos_epd_get_width(), mgos_epd_get_height());
 
 	mgos_epd_clear(UNCOLORED);
 	const char *istr = "MOS epaper lib";
-	mgos_epd_draw_string_at(100 - (Font16.Width*strlen(istr)/2), 4, istr, &Font16, COLORED);
+	mgos_epd_draw_string_at(100 - (Font16_RLE.Width*strlen(istr)/2), 4, istr, &Font16_RLE, COLORED);
 	mgos_epd_pushFrameBuffer(mgos_epd_getFrameBuffer(), 0, 30, mgos_epd_get_width(), mgos_epd_get_height());
 
 	mgos_epd_clear(UNCOLORED);
-	mgos_epd_draw_string_at(5, 4, "* Using native mgos_spi.h", &Font12, COLORED);
+	mgos_epd_draw_string_at(5, 4, "* Using native mgos_spi.h", &Font12_RLE, COLORED);
 	mgos_epd_pushFrameBuffer(mgos_epd_getFrameBuffer(), 0, 50, mgos_epd_get_width(), mgos_epd_get_height());
 
 /*
@@ -122,11 +116,6 @@ void epaper_demo(void)
 	mgos_epd_pushFrameBuffer(mgos_epd_getFrameBuffer(), 100, 130, mgos_epd_get_width(), mgos_epd_get_height());
 */
 
-	w = widget_create("time", 32, 60, 128, 30);
-	widget_set_handler(w, widget_time_ev, NULL);
-	widget_set_timer(w, 1000);
-	screen_widget_add(screen, w);
-
 	/** 
 	*  there are 2 memory areas embedded in the e-paper display
 	*  and once the display is refreshed, the memory area will be auto-toggled,
@@ -141,7 +130,11 @@ void epaper_demo(void)
 		return;
 	}
 
-	mgos_set_timer(943, 1, epaper_timer_cb, NULL);
+	/* the screen runs the widget timers and draws with one refresh per tick */
+	w = widget_create("time", 32, 60, 144, 112);
+	widget_set_handler(w, widget_time_ev, NULL);
+	widget_set_timer(w, 1000);
+	screen_widget_add(screen, w);
 }
 
 